@@ -0,0 +1,183 @@
+#include "Animation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+bool AnimationSet::loadFromFile(const std::string& descriptorPath, const std::string& textureDir) {
+    std::ifstream inputFile(descriptorPath);
+    if (!inputFile.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(inputFile, line)) {
+        std::istringstream tokens(line);
+        std::string keyword;
+        if (!(tokens >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+
+        if (keyword == "clip") {
+            Clip clip;
+            std::string mode;
+            if (!(tokens >> clip.name >> mode) || (mode != "loop" && mode != "once")) {
+                return false;
+            }
+            clip.loop = mode == "loop";
+            clips.push_back(clip);
+        } else if (keyword == "frame") {
+            std::string file;
+            float duration = 0.f;
+            if (clips.empty() || !(tokens >> file >> duration) || duration <= 0.f) {
+                return false;
+            }
+            int texture = loadTexture(textureDir + file);
+            if (texture < 0) {
+                return false;
+            }
+            Clip& clip = clips.back();
+            clip.totalTime += duration;
+            clip.textures.push_back(texture);
+            clip.frameEnds.push_back(clip.totalTime);
+        } else {
+            return false;
+        }
+    }
+
+    for (auto& clip : clips) {
+        if (clip.textures.empty()) {
+            return false;
+        }
+        buildBuckets(clip);
+    }
+    return true;
+}
+
+int AnimationSet::getClipId(const std::string& name) const {
+    for (std::size_t i = 0; i < clips.size(); ++i) {
+        if (clips[i].name == name) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+const AnimationSet::Clip& AnimationSet::getClip(int id) const {
+    return clips[id];
+}
+
+const sf::Texture& AnimationSet::getTexture(int id) const {
+    return textures[id];
+}
+
+std::size_t AnimationSet::getTextureCount() const {
+    return textures.size();
+}
+
+int AnimationSet::getFrameAt(int clipId, float time) const {
+    const Clip& clip = clips[clipId];
+    if (time >= clip.totalTime) {
+        time = clip.loop ? std::fmod(time, clip.totalTime) : clip.totalTime;
+    }
+
+    std::size_t bucket = std::min((std::size_t)(time / clip.bucketTime), clip.buckets.size() - 1);
+    int frame = clip.buckets[bucket];
+    if (frame + 1 < (int)clip.frameEnds.size() && time >= clip.frameEnds[frame]) {
+        ++frame;
+    }
+    return frame;
+}
+
+int AnimationSet::loadTexture(const std::string& path) {
+    auto found = textureIds.find(path);
+    if (found != textureIds.end()) {
+        return found->second;
+    }
+
+    sf::Texture texture;
+    if (!texture.loadFromFile(path)) {
+        return -1;
+    }
+    textures.push_back(texture);
+    textureIds[path] = (int)textures.size() - 1;
+    return (int)textures.size() - 1;
+}
+
+void AnimationSet::buildBuckets(Clip& clip) {
+    float shortest = clip.frameEnds[0];
+    for (std::size_t i = 1; i < clip.frameEnds.size(); ++i) {
+        shortest = std::min(shortest, clip.frameEnds[i] - clip.frameEnds[i - 1]);
+    }
+    clip.bucketTime = shortest;
+
+    std::size_t bucketCount = (std::size_t)std::ceil(clip.totalTime / clip.bucketTime) + 1;
+    clip.buckets.resize(bucketCount);
+    int current = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        float start = i * clip.bucketTime;
+        while (current + 1 < (int)clip.frameEnds.size() && start >= clip.frameEnds[current]) {
+            ++current;
+        }
+        clip.buckets[i] = current;
+    }
+}
+
+void Animator::setAnimationSet(const AnimationSet& set) {
+    animations = &set;
+    clipId = -1;
+    frame = -1;
+}
+
+// Switching to the clip already playing keeps its place, so state-driven
+// calls every frame don't stall the animation.
+void Animator::play(int clip) {
+    if (clip == clipId) {
+        return;
+    }
+    restart(clip);
+}
+
+// Starts the clip from its first frame even if it is already playing.
+void Animator::restart(int clip) {
+    clipId = clip;
+    elapsed = 0.f;
+    frame = -1;
+}
+
+bool Animator::update(float dt) {
+    const AnimationSet::Clip& clip = animations->getClip(clipId);
+
+    elapsed += dt;
+    if (elapsed >= clip.totalTime) {
+        elapsed = clip.loop ? std::fmod(elapsed, clip.totalTime) : clip.totalTime;
+    }
+
+    int next = animations->getFrameAt(clipId, elapsed);
+
+    if (next == frame) {
+        return false;
+    }
+    frame = next;
+    return true;
+}
+
+int Animator::getClipId() const {
+    return clipId;
+}
+
+int Animator::getFrame() const {
+    return frame;
+}
+
+const sf::Texture& Animator::getTexture() const {
+    const AnimationSet::Clip& clip = animations->getClip(clipId);
+    return animations->getTexture(clip.textures[std::max(frame, 0)]);
+}
+
+void Animator::apply(sf::Sprite& sprite, int width, int height) const {
+    const sf::Texture& texture = getTexture();
+    sprite.setTexture(texture);
+    sprite.setScale((float)width / texture.getSize().x, (float)height / texture.getSize().y);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+// Clips and their textures, loaded from a text descriptor:
+//   clip <name> <loop|once>
+//   frame <texture file> <seconds>
+class AnimationSet {
+public:
+    struct Clip {
+        std::string name;
+        bool loop = true;
+        std::vector<int> textures;
+        std::vector<float> frameEnds;
+        float totalTime = 0.f;
+        // Frame active at the start of each bucket. Buckets are no longer than
+        // the shortest frame, so a bucket holds at most one frame boundary.
+        float bucketTime = 0.f;
+        std::vector<int> buckets;
+    };
+
+private:
+    std::vector<sf::Texture> textures;
+    std::map<std::string, int> textureIds;
+    std::vector<Clip> clips;
+
+public:
+    bool loadFromFile(const std::string& descriptorPath, const std::string& textureDir);
+    int getClipId(const std::string& name) const;
+    const Clip& getClip(int id) const;
+    const sf::Texture& getTexture(int id) const;
+    std::size_t getTextureCount() const;
+    int getFrameAt(int clipId, float time) const;
+
+private:
+    int loadTexture(const std::string& path);
+    static void buildBuckets(Clip& clip);
+};
+
+class Animator {
+private:
+    const AnimationSet* animations = nullptr;
+    int clipId = -1;
+    int frame = -1;
+    float elapsed = 0.f;
+
+public:
+    void setAnimationSet(const AnimationSet& set);
+    void play(int clip);
+    void restart(int clip);
+    bool update(float dt);
+    int getClipId() const;
+    int getFrame() const;
+    const sf::Texture& getTexture() const;
+    void apply(sf::Sprite& sprite, int width, int height) const;
+};
\ No newline at end of file
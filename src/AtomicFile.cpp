@@ -0,0 +1,86 @@
+#include "AtomicFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool AtomicFile::write(const std::string& path, const std::vector<unsigned char>& bytes) {
+    std::filesystem::path target(path);
+    std::filesystem::path tmpPath(path + ".tmp");
+
+    HANDLE file = CreateFileW(tmpPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < bytes.size()) {
+        DWORD chunk = 0;
+        DWORD request = (DWORD)std::min<std::size_t>(bytes.size() - written, 1u << 30);
+        if (!WriteFile(file, bytes.data() + written, request, &chunk, nullptr) || chunk == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        written += chunk;
+    }
+    bool flushed = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    if (!flushed) {
+        return false;
+    }
+
+    // Unlike rename(), this replaces an existing target in one step, so there
+    // is no moment where neither file exists.
+    return MoveFileExW(tmpPath.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+bool AtomicFile::write(const std::string& path, const std::vector<unsigned char>& bytes) {
+    std::string tmpPath = path + ".tmp";
+
+    int file = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t chunk = ::write(file, bytes.data() + written, bytes.size() - written);
+        if (chunk <= 0) {
+            ::close(file);
+            return false;
+        }
+        written += (std::size_t)chunk;
+    }
+    // Without this the rename can reach the disk before the data does, and a
+    // power loss leaves an empty file under the final name.
+    bool synced = fsync(file) == 0;
+    if (::close(file) != 0 || !synced) {
+        return false;
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+
+    // The rename itself lives in the directory, which needs its own flush.
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    int directory = ::open(parent.empty() ? "." : parent.c_str(), O_RDONLY | O_DIRECTORY);
+    if (directory >= 0) {
+        fsync(directory);
+        ::close(directory);
+    }
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace AtomicFile {
+    // Replaces `path` with `bytes` so that after a crash or power loss the
+    // file holds either the old or the new contents, never a torn mix. The
+    // data goes to path + ".tmp", is flushed to the device, and is renamed
+    // over the target; on POSIX the directory entry is flushed too.
+    bool write(const std::string& path, const std::vector<unsigned char>& bytes);
+}
\ No newline at end of file
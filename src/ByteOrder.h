@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+// Little-endian field access for the game's binary file formats, independent
+// of the host byte order.
+namespace ByteOrder {
+    inline void putU16(unsigned char* out, std::uint16_t value) {
+        out[0] = static_cast<unsigned char>(value);
+        out[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    inline void putU32(unsigned char* out, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    inline void putU64(unsigned char* out, std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    inline std::uint16_t getU16(const unsigned char* in) {
+        return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    inline std::uint32_t getU32(const unsigned char* in) {
+        std::uint32_t value = 0;
+        for (int i = 3; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    inline std::uint64_t getU64(const unsigned char* in) {
+        std::uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+}
\ No newline at end of file
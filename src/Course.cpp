@@ -0,0 +1,298 @@
+#include "Course.h"
+
+#include <algorithm>
+
+#include "ByteOrder.h"
+
+namespace {
+    void putVarint(std::vector<unsigned char>& out, std::uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    bool getVarint(const unsigned char*& in, const unsigned char* end, std::uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35 && in != end; shift += 7) {
+            unsigned char byte = *in++;
+            value |= (std::uint32_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Zigzag maps small negative deltas to small unsigned values.
+    std::uint32_t zigzag(int value) {
+        return ((std::uint32_t)value << 1) ^ (std::uint32_t)(value >> 31);
+    }
+
+    int unzigzag(std::uint32_t value) {
+        return (int)(value >> 1) ^ -(int)(value & 1);
+    }
+}
+
+bool Course::loadFromFile(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    const unsigned char* data = file.getData();
+    std::size_t size = file.getSize();
+    if (size < HEADER_SIZE || ByteOrder::getU32(data) != FILE_MAGIC || ByteOrder::getU16(data + 4) != FILE_VERSION) {
+        file.close();
+        return false;
+    }
+
+    chunkSize = ByteOrder::getU16(data + 6);
+    chunkCount = ByteOrder::getU32(data + 8);
+    tickRate = ByteOrder::getU16(data + 12);
+    spikeCount = ByteOrder::getU64(data + 16);
+    indexOffset = ByteOrder::getU64(data + 24);
+
+    // Only the header and index bounds are checked here; each chunk is
+    // checked when it is decoded, so opening does not depend on course length.
+    bool valid = chunkSize > 0
+        && chunkCount == (spikeCount + chunkSize - 1) / chunkSize
+        && indexOffset >= HEADER_SIZE && indexOffset <= size
+        && (size - indexOffset) / INDEX_ENTRY_SIZE >= chunkCount;
+    if (!valid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Course::close() {
+    file.close();
+    chunkSize = 0;
+    chunkCount = 0;
+    tickRate = 0;
+    spikeCount = 0;
+    indexOffset = 0;
+}
+
+bool Course::isLoaded() const {
+    return file.isOpen();
+}
+
+int Course::getTickRate() const {
+    return tickRate;
+}
+
+std::uint64_t Course::getSpikeCount() const {
+    return spikeCount;
+}
+
+std::uint32_t Course::getChunkCount() const {
+    return chunkCount;
+}
+
+bool Course::decodeChunk(std::uint32_t chunk, std::vector<Spike>& spikes) const {
+    spikes.clear();
+    if (chunk >= chunkCount) {
+        return false;
+    }
+    const unsigned char* entry = file.getData() + indexOffset + (std::size_t)chunk * INDEX_ENTRY_SIZE;
+    std::uint64_t offset = ByteOrder::getU64(entry);
+    std::uint32_t byteSize = ByteOrder::getU32(entry + 12);
+    if (offset < HEADER_SIZE || offset > indexOffset || byteSize > indexOffset - offset) {
+        return false;
+    }
+
+    std::size_t count = (std::size_t)std::min<std::uint64_t>(chunkSize, spikeCount - (std::uint64_t)chunk * chunkSize);
+    const unsigned char* in = file.getData() + offset;
+    const unsigned char* end = in + byteSize;
+    Spike spike;
+    spike.tick = ByteOrder::getU32(entry + 8);
+    spikes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t tickDelta, widthDelta, heightDelta, speedDelta;
+        if (!getVarint(in, end, tickDelta) || !getVarint(in, end, widthDelta)
+            || !getVarint(in, end, heightDelta) || !getVarint(in, end, speedDelta)) {
+            spikes.clear();
+            return false;
+        }
+        spike.tick += tickDelta;
+        spike.width += unzigzag(widthDelta);
+        spike.height += unzigzag(heightDelta);
+        spike.speed += unzigzag(speedDelta);
+        // A spike that does not move never leaves the field.
+        if (spike.width <= 0 || spike.height <= 0 || spike.speed <= 0) {
+            spikes.clear();
+            return false;
+        }
+        spikes.push_back(spike);
+    }
+    return true;
+}
+
+void Course::prefetchChunk(std::uint32_t chunk) const {
+    if (chunk >= chunkCount) {
+        return;
+    }
+    const unsigned char* entry = file.getData() + indexOffset + (std::size_t)chunk * INDEX_ENTRY_SIZE;
+    file.prefetch((std::size_t)ByteOrder::getU64(entry), ByteOrder::getU32(entry + 12));
+}
+
+void Course::releaseChunk(std::uint32_t chunk) const {
+    if (chunk >= chunkCount) {
+        return;
+    }
+    const unsigned char* entry = file.getData() + indexOffset + (std::size_t)chunk * INDEX_ENTRY_SIZE;
+    file.release((std::size_t)ByteOrder::getU64(entry), ByteOrder::getU32(entry + 12));
+}
+
+void CourseCursor::setCourse(const Course* newCourse) {
+    course = newCourse;
+    rewind();
+}
+
+void CourseCursor::rewind() {
+    spikes.clear();
+    nextChunk = 0;
+    index = 0;
+    position = 0;
+    prefetched = false;
+    finished = false;
+    failed = false;
+    if (course != nullptr) {
+        course->prefetchChunk(0);
+    }
+}
+
+bool CourseCursor::isActive() const {
+    return course != nullptr;
+}
+
+// Running out of chunks is the end of the course. A chunk that fails to
+// decode stops the course as failed rather than feeding the simulation
+// garbage, so a damaged file is never mistaken for a cleared course.
+const Course::Spike* CourseCursor::peek() {
+    if (course == nullptr || finished || failed) {
+        return nullptr;
+    }
+    if (index == spikes.size()) {
+        if (nextChunk == course->getChunkCount()) {
+            spikes.clear();
+            index = 0;
+            finished = true;
+            return nullptr;
+        }
+        if (!course->decodeChunk(nextChunk, spikes) || spikes.empty()) {
+            spikes.clear();
+            index = 0;
+            failed = true;
+            return nullptr;
+        }
+        course->releaseChunk(nextChunk);
+        ++nextChunk;
+        index = 0;
+        prefetched = false;
+    }
+    if (!prefetched && index >= spikes.size() / 2) {
+        course->prefetchChunk(nextChunk);
+        prefetched = true;
+    }
+    return &spikes[index];
+}
+
+void CourseCursor::advance() {
+    ++index;
+    ++position;
+}
+
+std::uint64_t CourseCursor::getPosition() const {
+    return position;
+}
+
+bool CourseCursor::isFinished() const {
+    return finished;
+}
+
+bool CourseCursor::isFailed() const {
+    return failed;
+}
+
+bool CourseWriter::open(const std::string& path, int courseTickRate, std::uint16_t spikesPerChunk) {
+    outputFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!outputFile.is_open()) {
+        return false;
+    }
+    // The header is rewritten by finish() once the counts are known.
+    unsigned char header[Course::HEADER_SIZE] = {};
+    outputFile.write(reinterpret_cast<const char*>(header), Course::HEADER_SIZE);
+
+    chunkSize = std::max<std::uint16_t>(spikesPerChunk, 1);
+    tickRate = (std::uint16_t)courseTickRate;
+    spikeCount = 0;
+    offset = Course::HEADER_SIZE;
+    chunk.clear();
+    index.clear();
+    previous = Course::Spike();
+    chunkBaseTick = 0;
+    chunkRecords = 0;
+    return (bool)outputFile;
+}
+
+bool CourseWriter::add(const Course::Spike& spike) {
+    if (spike.tick < previous.tick || spike.width <= 0 || spike.height <= 0 || spike.speed <= 0) {
+        return false;
+    }
+    // Deltas restart from zero at each chunk so chunks decode independently.
+    Course::Spike base = previous;
+    if (chunkRecords == 0) {
+        chunkBaseTick = previous.tick;
+        base = Course::Spike();
+        base.tick = chunkBaseTick;
+    }
+    putVarint(chunk, spike.tick - base.tick);
+    putVarint(chunk, zigzag(spike.width - base.width));
+    putVarint(chunk, zigzag(spike.height - base.height));
+    putVarint(chunk, zigzag(spike.speed - base.speed));
+
+    previous = spike;
+    ++spikeCount;
+    if (++chunkRecords == chunkSize) {
+        flushChunk();
+    }
+    return true;
+}
+
+bool CourseWriter::finish() {
+    flushChunk();
+    std::uint64_t indexOffset = offset;
+    outputFile.write(reinterpret_cast<const char*>(index.data()), index.size());
+
+    unsigned char header[Course::HEADER_SIZE] = {};
+    ByteOrder::putU32(header, Course::FILE_MAGIC);
+    ByteOrder::putU16(header + 4, Course::FILE_VERSION);
+    ByteOrder::putU16(header + 6, chunkSize);
+    ByteOrder::putU32(header + 8, (std::uint32_t)(index.size() / Course::INDEX_ENTRY_SIZE));
+    ByteOrder::putU16(header + 12, tickRate);
+    ByteOrder::putU64(header + 16, spikeCount);
+    ByteOrder::putU64(header + 24, indexOffset);
+    outputFile.seekp(0);
+    outputFile.write(reinterpret_cast<const char*>(header), Course::HEADER_SIZE);
+    outputFile.close();
+    return !outputFile.fail();
+}
+
+void CourseWriter::flushChunk() {
+    if (chunkRecords == 0) {
+        return;
+    }
+    unsigned char entry[Course::INDEX_ENTRY_SIZE];
+    ByteOrder::putU64(entry, offset);
+    ByteOrder::putU32(entry + 8, chunkBaseTick);
+    ByteOrder::putU32(entry + 12, (std::uint32_t)chunk.size());
+    index.insert(index.end(), entry, entry + Course::INDEX_ENTRY_SIZE);
+
+    outputFile.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    offset += chunk.size();
+    chunk.clear();
+    chunkRecords = 0;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+// An authored sequence of spikes, memory-mapped from disk. Records are stored
+// in fixed-size chunks; within a chunk every field is a varint delta from the
+// previous record, so a chunk decodes on its own from its index entry.
+//
+//   header   magic, version, chunk size, chunk count, tick rate, spike count,
+//            index offset (32 bytes)
+//   chunks   per spike: tick delta, then zigzag width, height, speed deltas
+//   index    per chunk: file offset, tick before its first spike, byte size
+class Course {
+public:
+    struct Spike {
+        std::uint32_t tick = 0;
+        int width = 0;
+        int height = 0;
+        int speed = 0;
+    };
+
+    static const std::uint32_t FILE_MAGIC = 0x53435749; // "IWCS"
+    static const std::uint16_t FILE_VERSION = 1;
+    static const std::size_t HEADER_SIZE = 32;
+    static const std::size_t INDEX_ENTRY_SIZE = 16;
+
+private:
+    MappedFile file;
+    std::uint16_t chunkSize = 0;
+    std::uint32_t chunkCount = 0;
+    std::uint16_t tickRate = 0;
+    std::uint64_t spikeCount = 0;
+    std::uint64_t indexOffset = 0;
+
+public:
+    bool loadFromFile(const std::string& path);
+    void close();
+    bool isLoaded() const;
+    int getTickRate() const;
+    std::uint64_t getSpikeCount() const;
+    std::uint32_t getChunkCount() const;
+    bool decodeChunk(std::uint32_t chunk, std::vector<Spike>& spikes) const;
+    void prefetchChunk(std::uint32_t chunk) const;
+    void releaseChunk(std::uint32_t chunk) const;
+};
+
+// Walks a course one spike at a time, holding only the current chunk
+// decoded. The page-in of the next chunk is requested halfway through the
+// current one so it is resident by the time the cursor reaches it, and a
+// chunk's pages are dropped once it is decoded, so memory stays flat however
+// long the course is.
+class CourseCursor {
+private:
+    const Course* course = nullptr;
+    std::vector<Course::Spike> spikes;
+    std::uint32_t nextChunk = 0;
+    std::size_t index = 0;
+    std::uint64_t position = 0;
+    bool prefetched = false;
+    bool finished = false;
+    bool failed = false;
+
+public:
+    void setCourse(const Course* newCourse);
+    void rewind();
+    bool isActive() const;
+    const Course::Spike* peek();
+    void advance();
+    std::uint64_t getPosition() const;
+    bool isFinished() const;
+    bool isFailed() const;
+};
+
+// Streams spikes into a course file, so courses of any length are written
+// with one chunk in memory. Ticks must not decrease and sizes and speeds
+// must be positive.
+class CourseWriter {
+private:
+    std::ofstream outputFile;
+    std::uint16_t chunkSize = 0;
+    std::uint16_t tickRate = 0;
+    std::uint64_t spikeCount = 0;
+    std::uint64_t offset = 0;
+    std::vector<unsigned char> chunk;
+    std::vector<unsigned char> index;
+    Course::Spike previous;
+    std::uint32_t chunkBaseTick = 0;
+    std::size_t chunkRecords = 0;
+
+public:
+    static const std::uint16_t DEFAULT_CHUNK_SIZE = 4096;
+
+    bool open(const std::string& path, int courseTickRate, std::uint16_t spikesPerChunk = DEFAULT_CHUNK_SIZE);
+    bool add(const Course::Spike& spike);
+    bool finish();
+
+private:
+    void flushChunk();
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "FileWriter.h"
+
+#include <filesystem>
+
+#include "AtomicFile.h"
+
+FileWriter::FileWriter() {
+    writer = std::thread(&FileWriter::writerLoop, this);
+}
+
+FileWriter::~FileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+void FileWriter::write(std::vector<std::string> paths, Encoder encode) {
+    post([paths = std::move(paths), encode = std::move(encode)] { writeAll(paths, encode); });
+}
+
+void FileWriter::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wakeUp.notify_one();
+}
+
+void FileWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeUp.wait(lock, [this] { return !tasks.empty() || stopping; });
+
+        if (!tasks.empty()) {
+            Task task = std::move(tasks.front());
+            tasks.pop_front();
+
+            lock.unlock();
+            task();
+            lock.lock();
+        } else if (stopping) {
+            return;
+        }
+    }
+}
+
+void FileWriter::writeAll(const std::vector<std::string>& paths, const Encoder& encode) {
+    std::vector<unsigned char> bytes;
+    encode(bytes);
+    for (const std::string& path : paths) {
+        std::error_code error;
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) {
+            std::filesystem::create_directories(parent, error);
+        }
+        AtomicFile::write(path, bytes);
+    }
+}
\ No newline at end of file
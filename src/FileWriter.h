@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Write-behind file output for the game thread. A write hands over the data
+// to save, which is encoded on the writer thread and committed atomically to
+// each of its paths. Other file work, such as deleting files, can be queued
+// as a task. Everything runs in submission order, and queued work is finished
+// before the writer is destroyed.
+class FileWriter {
+public:
+    using Encoder = std::function<void(std::vector<unsigned char>& bytes)>;
+    using Task = std::function<void()>;
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<Task> tasks;
+    bool stopping = false;
+    std::thread writer;
+
+public:
+    FileWriter();
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    void write(std::vector<std::string> paths, Encoder encode);
+    void post(Task task);
+
+private:
+    void writerLoop();
+    static void writeAll(const std::vector<std::string>& paths, const Encoder& encode);
+};
\ No newline at end of file
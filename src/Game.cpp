@@ -1,15 +1,33 @@
 #include "Game.h"
 
-#include <algorithm>
 #include <cstdlib>
-#include <fstream>
+#include <ctime>
+#include <filesystem>
 
 #include "Random.h"
 
-Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "I Wanna Celeste"), instShow(true), state(GameState::MENU) {
+namespace {
+    // Saved runs are named after their leaderboard entry, so the files of a
+    // run that drops off the board can be found again.
+    std::string runName(std::uint32_t seed, std::int64_t timestamp) {
+        return std::to_string(seed) + "-" + std::to_string(timestamp);
+    }
+
+    // Only the named files are touched; anything else kept in the directory,
+    // such as a determinism corpus, is left alone.
+    void removeRuns(const std::vector<std::string>& names) {
+        std::error_code error;
+        for (const std::string& name : names) {
+            std::filesystem::remove(name + ".replay", error);
+            std::filesystem::remove(name + ".trace", error);
+        }
+    }
+}
+
+Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "I Wanna Celeste"), leaderboard("leaderboard.dat", "highscore.txt"), telemetry("telemetry.bin"), racing(false), coursing(false), instShow(true), state(GameState::MENU) {
     window.setFramerateLimit(FRAME_RATE);
 
-    if (!font.loadFromFile("../resources/arial.ttf")) {
+    if (!scene.loadFromDirectory("../resources/", simulation)) {
         exit(EXIT_FAILURE);
     }
 
@@ -22,63 +40,21 @@ Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "I Wanna Celes
         bgmMenu.setVolume(MAX_VOLUME);
     }
 
-    if (!backgroundTexture.loadFromFile("../resources/background.png") || !landTexture.loadFromFile("../resources/land.png")) {
-        exit(EXIT_FAILURE);
-    } else {
-        background.setTexture(backgroundTexture);
-        land.setTexture(landTexture);
-    }
-
-    sf::Texture tmpTexture;
-
-    for (int i = 0; i < 4; ++i) {
-        if (!tmpTexture.loadFromFile("../resources/run" + std::to_string(i) + ".png")) {
-            exit(EXIT_FAILURE);
-        } else {
-            runTextures.push_back(tmpTexture);
-        }
-    }
-
-    for (int i = 0; i < 2; ++i) {
-        if (!tmpTexture.loadFromFile("../resources/jump" + std::to_string(i) + ".png")) {
-            exit(EXIT_FAILURE);
-        } else {
-            riseTextures.push_back(tmpTexture);
-        }
-    }
-
-    for (int i = 0; i < 2; ++i) {
-        if (!tmpTexture.loadFromFile("../resources/fall" + std::to_string(i) + ".png")) {
-            exit(EXIT_FAILURE);
-        } else {
-            fallTextures.push_back(tmpTexture);
-        }
-    }
+    scene.reset(simulation);
 
-    if (!spikeTexture.loadFromFile("../resources/spike.png") || !snowTexture.loadFromFile("../resources/snowflake.png")) {
-        exit(EXIT_FAILURE);
-    }
-
-    kid.setTexture(runTextures[0]);
-    kid.setGroundPos(GROUND_POS);
-
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(40);
-    scoreText.setFillColor(sf::Color::White);
-    scoreText.setPosition(20, 20);
-
-    titleText.setFont(font);
+    titleText.setFont(scene.getFont());
     titleText.setCharacterSize(200);
 
-    subText.setFont(font);
+    subText.setFont(scene.getFont());
     subText.setCharacterSize(60);
 
-    std::ifstream inputFile("highscore.txt");
-    if (inputFile.is_open()) {
-        inputFile >> highScore;
-        inputFile.close();
-    } else {
-        highScore = 0;
+    leaderboard.load();
+    highScore = leaderboard.getHighScore();
+
+    // The course is optional content; course ticks only line up with a
+    // simulation running at the rate it was authored for.
+    if (course.loadFromFile(COURSE_PATH) && course.getTickRate() != simulation.getTickRate()) {
+        course.close();
     }
 }
 
@@ -97,7 +73,14 @@ void Game::processEvents() {
             window.close();
 
         if (state == GameState::MENU) {
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter) {
+            if (event.type == sf::Event::KeyPressed && (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::G
+                || (event.key.code == sf::Keyboard::C && course.isLoaded()))) {
+                racing = event.key.code == sf::Keyboard::G && !leaderboard.getEntries().empty();
+                coursing = event.key.code == sf::Keyboard::C;
+                // Ghosts are loaded once per race; restarts reuse them.
+                if (racing) {
+                    ghosts.loadFromDirectory(REPLAY_DIR, leaderboard.getEntries().front().seed, simulation.getTickRate(), MAX_GHOSTS);
+                }
                 resetGame();
                 bgmMenu.stop();
                 bgmGaming.play();
@@ -168,142 +151,100 @@ void Game::update() {
 
     if (state != GameState::PLAYING) return;
 
+    telemetry.frame(dt);
+
     if (instShow) {
         instTimer += dt;
         if (instTimer > 5.f) instShow = false;
     }
 
-    kidTimer += dt;
-    if (kidTimer >= KID_UPDATE_DELAY) {
-        kidTimer -= KID_UPDATE_DELAY;
-
-        sf::Texture* currentTexture = nullptr;
-
-        switch (kid.getState()) {
-            case Kid::KidState::RUNNING:
-                currentTexture = &runTextures[runFrame];
-                runFrame = (runFrame + 1) % runTextures.size();
-                break;
-            case Kid::KidState::JUMPING:
-            case Kid::KidState::RISING:
-                currentTexture = &riseTextures[riseFrame];
-                riseFrame = (riseFrame + 1) % riseTextures.size();
-                break;
-            case Kid::KidState::FALLING:
-                currentTexture = &fallTextures[fallFrame];
-                fallFrame = (fallFrame + 1) % fallTextures.size();
-                break;
-        }
-
-        if (currentTexture) {
-            kid.setTexture(*currentTexture);
+    // The simulation runs in fixed ticks so a recorded run replays exactly;
+    // a long stall only catches up a few ticks instead of spiralling.
+    tickAccumulator += dt;
+    int steps = 0;
+    while (tickAccumulator >= simulation.getTickTime() && state == GameState::PLAYING) {
+        tickAccumulator -= simulation.getTickTime();
+        step();
+        if (++steps == MAX_TICKS_PER_FRAME) {
+            tickAccumulator = 0.f;
         }
     }
+}
 
-    kid.move(dt);
-
-    spikeTimer += dt;
-    if (spikeTimer >= spikeDelay) {
-        spikeTimer -= spikeDelay;
-        spikeDelay = std::max(INITIAL_SPIKE_DELAY - score / 1000.f + Random::nextInt(SPIKE_DELAY_RANGE) / 1000.f, MIN_SPIKE_DELAY);
-
-        Spike newSpike;
-        newSpike.setSpikeWidth(MIN_SPIKE_WIDTH + Random::nextInt(SPIKE_WIDTH_RANGE));
-        newSpike.setSpikeHeight(MIN_SPIKE_HEIGHT + Random::nextInt(SPIKE_HEIGHT_RANGE));
-        newSpike.setVelocityX(std::min(MIN_SPIKE_SPEED + score / 2 + Random::nextInt(SPIKE_SPEED_RANGE), MAX_SPIKE_SPEED));
-        newSpike.setPassed(false);
-        newSpike.spawn(spikeTexture, WINDOW_WIDTH, GROUND_POS);
+void Game::step() {
+    bool isJumpPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    replay.record(isJumpPressed);
 
-        spikes.push_back(newSpike);
+    Simulation::Events events = simulation.step(isJumpPressed);
+    trace.record(simulation);
+    telemetry.setTick(simulation.getTick());
+    if (racing) {
+        ghosts.step(simulation.getTickTime());
     }
+    scene.animate(simulation, simulation.getTickTime());
 
-    if (!spikes.empty()) {
-        if (spikes[0].getSprite().getPosition().x < -spikes[0].getSpikeWidth()) {
-            spikes.pop_front();
-        }
+    if (events.jumped) {
+        telemetry.jump(simulation.getScore());
     }
-
-    for (auto& spike : spikes) {
-        spike.move(dt);
-
-        float spikeRight = spike.getSprite().getPosition().x + spike.getSpikeWidth();
-        float kidLeft = kid.getSprite().getPosition().x;
-
-        if (spikeRight < kidLeft && !spike.isPassed()) {
-            spike.setPassed(true);
-            score += 10;
-            if (score > highScore) {
-                highScore = score;
-            }
-        }
+    if (events.spawned) {
+        telemetry.spawn(events.spikeWidth, events.spikeHeight, events.spikeSpeed, events.nextSpikeDelay);
+    }
+    for (int i = events.passed - 1; i >= 0; --i) {
+        telemetry.pass(simulation.getScore() - 10 * i);
+    }
+    if (simulation.getScore() > highScore && !coursing) {
+        highScore = simulation.getScore();
     }
 
-    sf::FloatRect kidBounds = kid.getSprite().getGlobalBounds();
-    kidBounds.width *= 0.35f;
-    kidBounds.height *= 0.66f;
-    kidBounds.left += kid.getSprite().getGlobalBounds().width * 0.34f;
-    kidBounds.top += kid.getSprite().getGlobalBounds().height * 0.34f;
-
-    for (auto& spike : spikes) {
-        if (!kidBounds.intersects(spike.getSprite().getGlobalBounds())) {
-            continue;
-        }
-
-        sf::Vector2f spikePos = spike.getSprite().getPosition();
-        float spikeW = (float)spike.getSpikeWidth();
-        float spikeH = (float)spike.getSpikeHeight();
-
-        sf::Vector2f top(spikePos.x + spikeW / 2.f, spikePos.y);
-        sf::Vector2f botLeft(spikePos.x, spikePos.y + spikeH);
-        sf::Vector2f botRight(spikePos.x + spikeW, spikePos.y + spikeH);
-
-        std::vector<sf::Vector2f> kidPoints;
-        kidPoints.push_back(sf::Vector2f(kidBounds.left, kidBounds.top + kidBounds.height));
-        kidPoints.push_back(sf::Vector2f(kidBounds.left + kidBounds.width, kidBounds.top + kidBounds.height));
-        kidPoints.push_back(sf::Vector2f(kidBounds.left + kidBounds.width / 2.f, kidBounds.top + kidBounds.height));
-
-        bool isDead = false;
-        for (const auto& point : kidPoints) {
-            if (isPointInTriangle(point, top, botLeft, botRight)) {
-                isDead = true;
-                break;
-            }
-        }
-
-        if (isDead) {
-            state = GameState::GAME_OVER;
-            std::ofstream outputFile("highscore.txt");
-            if (outputFile.is_open()) {
-                outputFile << highScore;
-                outputFile.close();
-            }
+    if (events.died) {
+        state = GameState::GAME_OVER;
+        sf::FloatRect kidBounds = simulation.getKid().getHitbox();
+        telemetry.death((int)simulation.getKid().getState(), simulation.getScore(), simulation.getGroundPos() - (kidBounds.top + kidBounds.height));
+        // Replays and the leaderboard only know seeds, so course runs
+        // stay out of both.
+        if (!coursing) {
+            std::int64_t timestamp = std::time(nullptr);
+            std::vector<Leaderboard::Entry> evicted;
+            bool onLeaderboard = leaderboard.submit(simulation.getScore(), simulation.getSeed(), timestamp, evicted);
+            saveReplay(onLeaderboard, timestamp, evicted);
         }
+    } else if (simulation.isCourseCleared() || simulation.isCourseFailed()) {
+        state = GameState::GAME_OVER;
     }
+}
 
-    snowTimer += dt;
-    if (snowTimer >= snowDelay) {
-        snowTimer -= snowDelay;
-        snowDelay = MIN_SNOW_DELAY + Random::nextInt(SNOW_DELAY_RANGE) / 1000.f;
-
-        Snow newSnowflake;
-        newSnowflake.setSnowWidth(MIN_SNOW_SIZE + Random::nextInt(SNOW_SIZE_RANGE));
-        newSnowflake.setSnowHeight(newSnowflake.getSnowWidth());
-        newSnowflake.setVelocityX(MIN_SNOW_XSPEED + Random::nextInt(SNOW_XSPEED_RANGE));
-        newSnowflake.setVelocityY(MIN_SNOW_YSPEED + Random::nextInt(SNOW_YSPEED_RANGE));
-        newSnowflake.setAngleVelocity(MIN_SNOW_ANGLE_SPEED + Random::nextInt(SNOW_ANGLE_SPEED_RANGE));
-        newSnowflake.spawn(snowTexture, WINDOW_WIDTH);
-
-        snowflakes.push_back(newSnowflake);
+void Game::saveReplay(bool onLeaderboard, std::int64_t timestamp, const std::vector<Leaderboard::Entry>& evicted) {
+    std::string name = REPLAY_DIR + runName(replay.getSeed(), timestamp);
+    std::vector<std::string> replayPaths = { REPLAY_DIR + "last.replay" };
+    // Each replay gets the state trace it produced, the golden record the
+    // determinism checker compares re-simulations against.
+    std::vector<std::string> tracePaths = { REPLAY_DIR + "last.trace" };
+    if (onLeaderboard) {
+        replayPaths.push_back(name + ".replay");
+        tracePaths.push_back(name + ".trace");
     }
-
-    if (!snowflakes.empty()) {
-        if (snowflakes[0].getSprite().getPosition().x < -snowflakes[0].getSnowWidth() / 2.f || snowflakes[0].getSprite().getPosition().y > GROUND_POS + snowflakes[0].getSnowHeight() / 2.f) {
-            snowflakes.pop_front();
+    // The run's inputs and hashes move to the writer thread, which encodes
+    // and saves them; the death tick does no file I/O. resetGame() restarts
+    // both recordings.
+    files.write(replayPaths, [run = std::move(replay)](std::vector<unsigned char>& bytes) {
+        run.encode(bytes);
+    });
+    files.write(tracePaths, [run = std::move(trace)](std::vector<unsigned char>& bytes) {
+        run.encode(bytes);
+    });
+
+    // The run this one pushed off the board loses its files too. A name
+    // equal to the new run's (same seed, same second) was just overwritten
+    // and stays.
+    std::vector<std::string> stale;
+    for (const Leaderboard::Entry& entry : evicted) {
+        std::string staleName = REPLAY_DIR + runName(entry.seed, entry.timestamp);
+        if (staleName != name) {
+            stale.push_back(staleName);
         }
     }
-
-    for (auto& snow : snowflakes) {
-        snow.move(dt);
+    if (!stale.empty()) {
+        files.post([stale = std::move(stale)] { removeRuns(stale); });
     }
 }
 
@@ -312,36 +253,30 @@ void Game::render() {
 
     switch (state) {
         case GameState::MENU:
-            window.draw(background);
-            window.draw(land);
+            scene.drawBackdrop(window);
 
             drawTitle("I Wanna Celeste", sf::Color(0, 192, 255));
-            drawSubtext("High Score: " + std::to_string(highScore) + "\nPress ENTER to Start\nPress ESC to Exit", sf::Color::White);
+            drawSubtext("High Score: " + std::to_string(highScore) + "\nPress ENTER to Start\nPress G to Race Ghosts\n" + (course.isLoaded() ? "Press C to Play Course\n" : "") + "Press ESC to Exit", sf::Color::White);
             break;
         case GameState::PLAYING:
-            window.draw(background);
-            drawSnow();
-            window.draw(land);
-            window.draw(kid.getSprite());
-            drawSpikes();
-
-            scoreText.setString("High Score: " + std::to_string(highScore) + "\nScore: " + std::to_string(score));
-            window.draw(scoreText);
+            scene.drawPlayfield(window, simulation, racing ? &ghosts : nullptr);
+            scene.drawScore(window, highScore, simulation.getScore());
             if (instShow) drawSubtext("Press SPACE to Jump\nPress P to Pause", sf::Color::White);
             break;
         case GameState::GAME_OVER:
-            window.draw(background);
-            window.draw(land);
-
-            drawTitle("Game Over", sf::Color(128, 0, 0));
-            drawSubtext("Your Score: " + std::to_string(score) + "\nHigh Score: " + std::to_string(highScore) + "\nPress R to Restart\nPress ESC to Menu", sf::Color::White);
+            scene.drawBackdrop(window);
+
+            if (simulation.isCourseCleared()) {
+                drawTitle("Course Clear", sf::Color(0, 192, 255));
+            } else if (simulation.isCourseFailed()) {
+                drawTitle("Course Damaged", sf::Color(128, 0, 0));
+            } else {
+                drawTitle("Game Over", sf::Color(128, 0, 0));
+            }
+            drawSubtext("Your Score: " + std::to_string(simulation.getScore()) + "\nHigh Score: " + std::to_string(highScore) + "\nPress R to Restart\nPress ESC to Menu", sf::Color::White);
             break;
         case GameState::PAUSED:
-            window.draw(background);
-            drawSnow();
-            window.draw(land);
-            window.draw(kid.getSprite());
-            drawSpikes();
+            scene.drawPlayfield(window, simulation, racing ? &ghosts : nullptr);
 
             sf::RectangleShape overlay(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
             overlay.setFillColor(sf::Color(0, 0, 0, 150));
@@ -356,21 +291,25 @@ void Game::render() {
 }
 
 void Game::resetGame() {
-    kid.reset();
-    score = 0;
+    simulation.setCourse(coursing ? &course : nullptr);
+
+    // A race replays the best run's seed so its ghost meets the same spikes.
+    if (racing) {
+        simulation.reset(leaderboard.getEntries().front().seed);
+        ghosts.reset(simulation.getKid());
+    } else {
+        simulation.reset(Random::freshSeed());
+        ghosts.clear();
+    }
+    scene.reset(simulation);
+    replay.start(simulation.getSeed(), simulation.getTickRate());
+    trace.start();
+    trace.record(simulation);
+    telemetry.beginRun(simulation.getSeed());
     state = GameState::PLAYING;
-    kidTimer = 0.f;
-    spikeTimer = 0.f;
-    snowTimer = 0.f;
     instTimer = 0.f;
+    tickAccumulator = 0.f;
     clock.restart();
-    spikeDelay = INITIAL_SPIKE_DELAY + Random::nextInt(SPIKE_DELAY_RANGE) / 1000.f;
-    spikes.clear();
-    snowDelay = MIN_SNOW_DELAY + Random::nextInt(SNOW_DELAY_RANGE) / 1000.f;
-    snowflakes.clear();
-    runFrame = 0;
-    riseFrame = 0;
-    fallFrame = 0;
 }
 
 void Game::drawTitle(std::string title, sf::Color color) {
@@ -391,34 +330,4 @@ void Game::drawSubtext(std::string subtext, sf::Color color) {
     subText.setPosition(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 1.8f);
 
     window.draw(subText);
-}
-
-void Game::drawSpikes() {
-    for (auto& spike : spikes) {
-        window.draw(spike.getSprite());
-    }
-}
-
-float Game::sign(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3) {
-    return (p1.x - p3.x) * (p2.y - p3.y) - (p2.x - p3.x) * (p1.y - p3.y);
-}
-
-bool Game::isPointInTriangle(sf::Vector2f pt, sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3) {
-    float d1, d2, d3;
-    bool has_neg, has_pos;
-
-    d1 = sign(pt, v1, v2);
-    d2 = sign(pt, v2, v3);
-    d3 = sign(pt, v3, v1);
-
-    has_neg = (d1 < 0) || (d2 < 0) || (d3 < 0);
-    has_pos = (d1 > 0) || (d2 > 0) || (d3 > 0);
-
-    return !(has_neg && has_pos);
-}
-
-void Game::drawSnow() {
-    for (auto& snow : snowflakes) {
-        window.draw(snow.getSprite());
-    }
 }
\ No newline at end of file
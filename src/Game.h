@@ -2,13 +2,17 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio/Music.hpp>
-#include <vector>
-#include <deque>
 #include <string>
 
-#include "Kid.h"
-#include "Spike.h"
-#include "Snow.h"
+#include "Course.h"
+#include "FileWriter.h"
+#include "GhostPack.h"
+#include "Leaderboard.h"
+#include "Replay.h"
+#include "SceneRenderer.h"
+#include "Simulation.h"
+#include "StateTrace.h"
+#include "Telemetry.h"
 
 class Game {
 private:
@@ -16,20 +20,20 @@ private:
     const int WINDOW_HEIGHT = 1080;
     sf::RenderWindow window;
     const int FRAME_RATE = 50;
-    const int GROUND_POS = 913;
+    const int MAX_TICKS_PER_FRAME = 5;
+    const std::string REPLAY_DIR = "replays/";
+    const std::size_t MAX_GHOSTS = 128;
+    const std::string COURSE_PATH = "../resources/marathon.course";
 
-    std::vector<sf::Texture> runTextures;
-    std::vector<sf::Texture> riseTextures;
-    std::vector<sf::Texture> fallTextures;
-    Kid kid;
-    sf::Sprite background;
-    sf::Texture backgroundTexture;
-    sf::Sprite land;
-    sf::Texture landTexture;
-    sf::Texture spikeTexture;
-    std::deque<Spike> spikes;
-    sf::Texture snowTexture;
-    std::deque<Snow> snowflakes;
+    Simulation simulation;
+    SceneRenderer scene;
+    Replay replay;
+    StateTrace trace;
+    GhostPack ghosts;
+    Course course;
+    Leaderboard leaderboard;
+    Telemetry telemetry;
+    FileWriter files;
 
     enum class GameState {
         MENU,
@@ -40,45 +44,13 @@ private:
 
     GameState state;
     sf::Clock clock;
-    float kidTimer;
-    float spikeTimer;
-    float snowTimer;
+    float tickAccumulator;
     float instTimer;
-    const float KID_UPDATE_DELAY = 0.1f;
-    float spikeDelay;
-    float snowDelay;
-    int score;
     int highScore;
+    bool racing;
+    bool coursing;
     bool instShow;
 
-    int runFrame;
-    int riseFrame;
-    int fallFrame;
-
-    const float INITIAL_SPIKE_DELAY = 1.5f;
-    const int SPIKE_DELAY_RANGE = 600;
-    const float MIN_SPIKE_DELAY = 0.7f;
-    const int MIN_SPIKE_WIDTH = 40;
-    const int SPIKE_WIDTH_RANGE = 200;
-    const int MIN_SPIKE_HEIGHT = 50;
-    const int SPIKE_HEIGHT_RANGE = 250;
-    const int MIN_SPIKE_SPEED = 400;
-    const int SPIKE_SPEED_RANGE = 150;
-    const int MAX_SPIKE_SPEED = 1200;
-
-    const float MIN_SNOW_DELAY = 0.1f;
-    const int SNOW_DELAY_RANGE = 300;
-    const int MIN_SNOW_SIZE = 20;
-    const int SNOW_SIZE_RANGE = 60;
-    const int MIN_SNOW_XSPEED = 300;
-    const int SNOW_XSPEED_RANGE = 900;
-    const int MIN_SNOW_YSPEED = 200;
-    const int SNOW_YSPEED_RANGE = 600;
-    const int MIN_SNOW_ANGLE_SPEED = -120;
-    const int SNOW_ANGLE_SPEED_RANGE = 240;
-
-    sf::Font font;
-    sf::Text scoreText;
     sf::Text titleText;
     sf::Text subText;
 
@@ -96,12 +68,10 @@ public:
 private:
     void processEvents();
     void update();
+    void step();
+    void saveReplay(bool onLeaderboard, std::int64_t timestamp, const std::vector<Leaderboard::Entry>& evicted);
     void render();
     void resetGame();
     void drawTitle(std::string title, sf::Color color);
     void drawSubtext(std::string subtext, sf::Color color);
-    void drawSpikes();
-    float sign(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3);
-    bool isPointInTriangle(sf::Vector2f pt, sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3);
-    void drawSnow();
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "GhostPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+    // All ones when the condition holds, all zeros otherwise.
+    inline std::uint32_t mask(bool condition) {
+        return 0u - (std::uint32_t)condition;
+    }
+
+    // Picks a where the mask is set and b where it is clear, bit for bit.
+    inline float blend(std::uint32_t mask, float a, float b) {
+        std::uint32_t bitsA, bitsB;
+        std::memcpy(&bitsA, &a, sizeof(float));
+        std::memcpy(&bitsB, &b, sizeof(float));
+        std::uint32_t bits = (bitsA & mask) | (bitsB & ~mask);
+        float result;
+        std::memcpy(&result, &bits, sizeof(float));
+        return result;
+    }
+
+    // Same arithmetic as Kid::move without control flow, so the loop
+    // vectorizes. Every lane is 32 bits wide, both sides of each branch are
+    // computed, and each condition becomes an all-ones or all-zeros mask
+    // that picks one side bit for bit. Plain ternaries are not enough: the
+    // compiler threads the related conditions back into jumps. The arrays
+    // are passed as __restrict parameters because they never overlap;
+    // without that the alias checks between six arrays are too many and the
+    // loop stays scalar. The trip count is whole blocks, so no scalar tail
+    // is needed and -O2's cheap vectorizer takes the loop too.
+    void stepLanes(std::size_t blocks, float dt, float holdGravity, float naturalGravity, float startVelocity, float holdLimit, float groundY,
+        float* __restrict ys, float* __restrict velocities, float* __restrict timers,
+        std::uint32_t* __restrict states, std::uint32_t* __restrict wasPressed, const std::uint32_t* __restrict isPressed) {
+        const std::uint32_t running = (std::uint32_t)Kid::KidState::RUNNING;
+        const std::uint32_t jumping = (std::uint32_t)Kid::KidState::JUMPING;
+        const std::uint32_t rising = (std::uint32_t)Kid::KidState::RISING;
+        const std::uint32_t falling = (std::uint32_t)Kid::KidState::FALLING;
+
+        for (std::size_t i = 0; i < blocks * GhostPack::LANE_BLOCK; ++i) {
+            std::uint32_t current = states[i];
+            std::uint32_t pressed = isPressed[i];
+            std::uint32_t isRunning = mask(current == running);
+            std::uint32_t isJumping = mask(current == jumping);
+            std::uint32_t starts = isRunning & pressed & ~wasPressed[i];
+            std::uint32_t holding = isJumping & pressed & mask(timers[i] < holdLimit);
+
+            float gravity = blend(holding, holdGravity, naturalGravity);
+            float airVelocity = velocities[i] + gravity * dt;
+            float airY = ys[i] + airVelocity * dt;
+            std::uint32_t lands = mask(current == falling) & mask(airY >= groundY);
+            std::uint32_t peaks = mask(current == rising) & mask(airVelocity >= 0.f);
+            std::uint32_t releases = isJumping & ~holding;
+
+            float velocity = blend(isRunning, blend(starts, startVelocity, velocities[i]), airVelocity);
+            float y = blend(isRunning, ys[i], airY);
+            float timer = blend(holding, timers[i] + dt, blend(starts, 0.f, timers[i]));
+
+            std::uint32_t next = current;
+            next = (starts & jumping) | (~starts & next);
+            next = (releases & rising) | (~releases & next);
+            next = (peaks & falling) | (~peaks & next);
+            next = (lands & running) | (~lands & next);
+
+            ys[i] = blend(lands, groundY, y);
+            velocities[i] = blend(lands, 0.f, velocity);
+            timers[i] = timer;
+            states[i] = next;
+            wasPressed[i] = pressed;
+        }
+    }
+}
+
+// Only runs on the race's seed met the same spikes, so other seeds are
+// skipped. Headers are read first and only the chosen runs are decoded; a
+// header claiming more ticks than its file holds fails there, so a damaged
+// file never sorts first and gets decoded.
+int GhostPack::loadFromDirectory(const std::string& directory, std::uint32_t seed, int tickRate, std::size_t maxGhosts) {
+    clear();
+
+    std::vector<std::pair<std::uint32_t, std::string>> candidates;
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+        if (file.path().extension() != ".replay" || file.path().stem() == "last") {
+            continue;
+        }
+
+        Replay header;
+        if (header.loadHeaderFromFile(file.path().string()) && header.getSeed() == seed && header.getTickRate() == tickRate) {
+            candidates.emplace_back(header.getLength(), file.path().string());
+        }
+    }
+
+    // Longest runs first, so a cap keeps the best ones.
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    if (candidates.size() > maxGhosts) {
+        candidates.resize(maxGhosts);
+    }
+    for (const auto& candidate : candidates) {
+        Replay replay;
+        if (replay.loadFromFile(candidate.second)) {
+            replays.push_back(std::move(replay));
+        }
+    }
+
+    // Lanes come in whole blocks so the stepping loop needs no scalar tail;
+    // the spare lanes never press jump and are never drawn.
+    std::size_t lanes = (replays.size() + LANE_BLOCK - 1) / LANE_BLOCK * LANE_BLOCK;
+    posY.assign(lanes, 0.f);
+    velocityY.assign(lanes, 0.f);
+    jumpTimer.assign(lanes, 0.f);
+    state.assign(lanes, 0);
+    wasJumpPressed.assign(lanes, 0);
+    isJumpPressed.assign(lanes, 0);
+    return (int)replays.size();
+}
+
+void GhostPack::clear() {
+    replays.clear();
+    posY.clear();
+    velocityY.clear();
+    jumpTimer.clear();
+    state.clear();
+    wasJumpPressed.clear();
+    isJumpPressed.clear();
+    tick = 0;
+}
+
+void GhostPack::reset(const Kid& kid) {
+    posX = (float)kid.X_POS;
+    restY = (float)(kid.groundPos - kid.KID_HEIGHT);
+    width = kid.KID_WIDTH;
+    height = kid.KID_HEIGHT;
+    gravityJumpHold = kid.GRAVITY_JUMP_HOLD;
+    gravityNatural = kid.GRAVITY_NATURAL;
+    initialVelocity = kid.INITIAL_VELOCITY;
+    maxJumpTime = kid.MAX_JUMP_TIME;
+
+    tick = 0;
+    std::fill(posY.begin(), posY.end(), restY);
+    std::fill(velocityY.begin(), velocityY.end(), 0.f);
+    std::fill(jumpTimer.begin(), jumpTimer.end(), 0.f);
+    std::fill(state.begin(), state.end(), (std::uint32_t)Kid::KidState::RUNNING);
+    std::fill(wasJumpPressed.begin(), wasJumpPressed.end(), 0);
+}
+
+void GhostPack::step(float dt) {
+    std::size_t count = replays.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        isJumpPressed[i] = mask(replays[i].isJumpPressed(tick));
+    }
+    ++tick;
+
+    stepLanes(posY.size() / LANE_BLOCK, dt, gravityJumpHold, gravityNatural, initialVelocity, maxJumpTime, restY,
+        posY.data(), velocityY.data(), jumpTimer.data(), state.data(), wasJumpPressed.data(), isJumpPressed.data());
+}
+
+std::size_t GhostPack::size() const {
+    return replays.size();
+}
+
+bool GhostPack::isActive(std::size_t ghost) const {
+    return tick < replays[ghost].getLength();
+}
+
+float GhostPack::getPosX() const {
+    return posX;
+}
+
+float GhostPack::getPosY(std::size_t ghost) const {
+    return posY[ghost];
+}
+
+Kid::KidState GhostPack::getState(std::size_t ghost) const {
+    return (Kid::KidState)state[ghost];
+}
+
+int GhostPack::getWidth() const {
+    return width;
+}
+
+int GhostPack::getHeight() const {
+    return height;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Kid.h"
+#include "Replay.h"
+
+// Replays many recorded runs alongside the live game. Only the Kid's motion
+// is re-simulated: a ghost follows its own inputs and disappears when its
+// recording ends. State is kept in parallel arrays of 32-bit lanes, flags as
+// all-ones/all-zeros masks, and stepped by one branch-free loop that the
+// compiler vectorizes and that reproduces Kid::move bit for bit.
+class GhostPack {
+private:
+    std::vector<Replay> replays;
+
+    std::vector<float> posY;
+    std::vector<float> velocityY;
+    std::vector<float> jumpTimer;
+    std::vector<std::uint32_t> state;
+    std::vector<std::uint32_t> wasJumpPressed;
+    std::vector<std::uint32_t> isJumpPressed;
+
+    std::uint32_t tick = 0;
+
+    // Copied from the live Kid in reset() so both integrate identically.
+    float posX = 0.f;
+    float restY = 0.f;
+    int width = 0;
+    int height = 0;
+    float gravityJumpHold = 0.f;
+    float gravityNatural = 0.f;
+    float initialVelocity = 0.f;
+    float maxJumpTime = 0.f;
+
+public:
+    // Lane arrays are padded to a multiple of this, one AVX vector of floats.
+    static const std::size_t LANE_BLOCK = 8;
+
+    int loadFromDirectory(const std::string& directory, std::uint32_t seed, int tickRate, std::size_t maxGhosts);
+    void clear();
+    void reset(const Kid& kid);
+    void step(float dt);
+
+    std::size_t size() const;
+    bool isActive(std::size_t ghost) const;
+    float getPosX() const;
+    float getPosY(std::size_t ghost) const;
+    Kid::KidState getState(std::size_t ghost) const;
+    int getWidth() const;
+    int getHeight() const;
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 void Kid::reset() {
     posY = groundPos - KID_HEIGHT;
     velocityY = 0.f;
+    jumpTimer = 0.f;
     kidState = KidState::RUNNING;
     wasJumpPressed = false;
     kidSprite.setPosition(X_POS, groundPos - KID_HEIGHT);
@@ -32,6 +33,18 @@ void Kid::setGroundPos(int position) {
     groundPos = position;
 }
 
+sf::FloatRect Kid::getHitbox() const {
+    return sf::FloatRect(X_POS + KID_WIDTH * 0.34f, posY + KID_HEIGHT * 0.34f, KID_WIDTH * 0.35f, KID_HEIGHT * 0.66f);
+}
+
+void Kid::hashState(StateHash& hash) const {
+    hash.add(posY);
+    hash.add(velocityY);
+    hash.add(jumpTimer);
+    hash.add((std::int32_t)kidState);
+    hash.add(wasJumpPressed);
+}
+
 void Kid::setTexture(const sf::Texture& texture) {
     kidSprite.setTexture(texture);
     float scaleX = (float)KID_WIDTH / texture.getSize().x;
@@ -39,9 +52,7 @@ void Kid::setTexture(const sf::Texture& texture) {
     kidSprite.setScale(scaleX, scaleY);
 }
 
-void Kid::move(float dt) {
-    bool isJumpPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
-
+void Kid::move(float dt, bool isJumpPressed) {
     switch (kidState) {
         case KidState::RUNNING:
             if (isJumpPressed && !wasJumpPressed) {
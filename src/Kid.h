@@ -2,7 +2,12 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "StateHash.h"
+
 class Kid {
+    // Steps many recorded Kids at once with the same tuning.
+    friend class GhostPack;
+
 public:
     enum class KidState {
         RUNNING,
@@ -34,13 +39,15 @@ public:
 
     void reset();
     void setTexture(const sf::Texture& texture);
-    void move(float dt);
+    void move(float dt, bool isJumpPressed);
     sf::Sprite& getSprite();
     const sf::Sprite& getSprite() const;
+    sf::FloatRect getHitbox() const;
     KidState getState() const;
     void setState(KidState state);
     int getGroundPos() const;
     void setGroundPos(int position);
+    void hashState(StateHash& hash) const;
 
 private:
     void startJump();
@@ -0,0 +1,168 @@
+#include "Leaderboard.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "AtomicFile.h"
+#include "ByteOrder.h"
+
+Leaderboard::Leaderboard(const std::string& filePath, const std::string& legacyFilePath) : path(filePath), legacyPath(legacyFilePath) {
+    writer = std::thread(&Leaderboard::writerLoop, this);
+}
+
+Leaderboard::~Leaderboard() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+void Leaderboard::load() {
+    entries.clear();
+    if (!loadBinary()) {
+        loadLegacy();
+    }
+}
+
+// Entries pushed off the board by this one are appended to evicted, so the
+// caller can drop whatever it keeps for them.
+bool Leaderboard::submit(int score, std::uint32_t seed, std::int64_t timestamp, std::vector<Entry>& evicted) {
+    if (score <= 0) {
+        return false;
+    }
+    if (entries.size() >= MAX_ENTRIES && score <= entries.back().score) {
+        return false;
+    }
+
+    Entry entry;
+    entry.score = score;
+    entry.timestamp = timestamp;
+    entry.seed = seed;
+
+    auto pos = std::upper_bound(entries.begin(), entries.end(), entry, [](const Entry& a, const Entry& b) {
+        return a.score > b.score;
+    });
+    entries.insert(pos, entry);
+    if (entries.size() > MAX_ENTRIES) {
+        evicted.push_back(entries.back());
+        entries.pop_back();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = entries;
+        hasPending = true;
+    }
+    wakeUp.notify_one();
+    return true;
+}
+
+int Leaderboard::getHighScore() const {
+    return entries.empty() ? 0 : entries.front().score;
+}
+
+const std::vector<Leaderboard::Entry>& Leaderboard::getEntries() const {
+    return entries;
+}
+
+bool Leaderboard::loadBinary() {
+    // Commits are atomic, but if the main file is missing or damaged anyway,
+    // a temporary file whose checksum matches is the newest good copy.
+    const std::string candidates[] = { path, path + ".tmp" };
+
+    for (const auto& candidate : candidates) {
+        std::ifstream inputFile(candidate, std::ios::binary | std::ios::ate);
+        if (!inputFile.is_open()) {
+            continue;
+        }
+
+        std::streamoff size = inputFile.tellg();
+        if (size < (std::streamoff)HEADER_SIZE) {
+            continue;
+        }
+        std::vector<unsigned char> buffer((std::size_t)size);
+        inputFile.seekg(0);
+        if (!inputFile.read(reinterpret_cast<char*>(buffer.data()), size)) {
+            continue;
+        }
+
+        const unsigned char* data = buffer.data();
+        std::uint16_t count = ByteOrder::getU16(data + 6);
+        if (ByteOrder::getU32(data) != FILE_MAGIC || ByteOrder::getU16(data + 4) != FILE_VERSION || count > MAX_ENTRIES) {
+            continue;
+        }
+        if (buffer.size() != HEADER_SIZE + count * ENTRY_SIZE || ByteOrder::getU32(data + 8) != checksum(data + HEADER_SIZE, count * ENTRY_SIZE)) {
+            continue;
+        }
+
+        entries.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const unsigned char* record = data + HEADER_SIZE + i * ENTRY_SIZE;
+            entries[i].score = static_cast<std::int32_t>(ByteOrder::getU32(record));
+            entries[i].timestamp = static_cast<std::int64_t>(ByteOrder::getU64(record + 4));
+            entries[i].seed = ByteOrder::getU32(record + 12);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool Leaderboard::loadLegacy() {
+    std::ifstream inputFile(legacyPath);
+    int score = 0;
+    if (!inputFile.is_open() || !(inputFile >> score) || score <= 0) {
+        return false;
+    }
+
+    Entry entry;
+    entry.score = score;
+    entries.push_back(entry);
+    return true;
+}
+
+void Leaderboard::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeUp.wait(lock, [this] { return hasPending || stopping; });
+
+        if (hasPending) {
+            std::vector<Entry> snapshot;
+            snapshot.swap(pending);
+            hasPending = false;
+
+            lock.unlock();
+            commit(snapshot);
+            lock.lock();
+        } else if (stopping) {
+            return;
+        }
+    }
+}
+
+bool Leaderboard::commit(const std::vector<Entry>& snapshot) const {
+    std::vector<unsigned char> buffer(HEADER_SIZE + snapshot.size() * ENTRY_SIZE);
+    unsigned char* body = buffer.data() + HEADER_SIZE;
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        unsigned char* record = body + i * ENTRY_SIZE;
+        ByteOrder::putU32(record, static_cast<std::uint32_t>(snapshot[i].score));
+        ByteOrder::putU64(record + 4, static_cast<std::uint64_t>(snapshot[i].timestamp));
+        ByteOrder::putU32(record + 12, snapshot[i].seed);
+    }
+
+    ByteOrder::putU32(buffer.data(), FILE_MAGIC);
+    ByteOrder::putU16(buffer.data() + 4, FILE_VERSION);
+    ByteOrder::putU16(buffer.data() + 6, static_cast<std::uint16_t>(snapshot.size()));
+    ByteOrder::putU32(buffer.data() + 8, checksum(body, snapshot.size() * ENTRY_SIZE));
+    return AtomicFile::write(path, buffer);
+}
+
+std::uint32_t Leaderboard::checksum(const unsigned char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Leaderboard {
+public:
+    struct Entry {
+        std::int32_t score = 0;
+        std::int64_t timestamp = 0;
+        std::uint32_t seed = 0;
+    };
+
+private:
+    static const std::size_t MAX_ENTRIES = 10;
+    static const std::uint32_t FILE_MAGIC = 0x4C435749; // "IWCL"
+    static const std::uint16_t FILE_VERSION = 1;
+    static const std::size_t HEADER_SIZE = 12;
+    static const std::size_t ENTRY_SIZE = 16;
+
+    std::string path;
+    std::string legacyPath;
+    std::vector<Entry> entries;
+
+    // Write-behind state: the game thread only swaps in a snapshot, the writer
+    // thread does the file I/O. Only the latest snapshot is kept.
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<Entry> pending;
+    bool hasPending = false;
+    bool stopping = false;
+    std::thread writer;
+
+public:
+    Leaderboard(const std::string& filePath, const std::string& legacyFilePath);
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    void load();
+    bool submit(int score, std::uint32_t seed, std::int64_t timestamp, std::vector<Entry>& evicted);
+    int getHighScore() const;
+    const std::vector<Entry>& getEntries() const;
+
+private:
+    bool loadBinary();
+    bool loadLegacy();
+    void writerLoop();
+    bool commit(const std::vector<Entry>& snapshot) const;
+    static std::uint32_t checksum(const unsigned char* data, std::size_t size);
+};
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(view);
+    size = (std::size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+// Windows reads ahead on sequential faults by itself and trims the working
+// set of a read-only view under pressure; neither hint is needed.
+void MappedFile::prefetch(std::size_t, std::size_t) const {
+}
+
+void MappedFile::release(std::size_t, std::size_t) const {
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+    // The mapping keeps its own reference, so the descriptor can go now.
+    void* view = mmap(nullptr, (std::size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(view);
+    size = (std::size_t)status.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+}
+
+void MappedFile::prefetch(std::size_t offset, std::size_t length) const {
+    if (data == nullptr || offset >= size) {
+        return;
+    }
+    // madvise wants a page-aligned start.
+    std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+    std::size_t start = offset / page * page;
+    std::size_t end = length < size - offset ? offset + length : size;
+    madvise(const_cast<unsigned char*>(data) + start, end - start, MADV_WILLNEED);
+}
+
+// Drops the pages wholly inside the range. They are clean file pages, so a
+// later read simply faults them back in from the file.
+void MappedFile::release(std::size_t offset, std::size_t length) const {
+    if (data == nullptr || offset >= size) {
+        return;
+    }
+    std::size_t page = (std::size_t)sysconf(_SC_PAGESIZE);
+    std::size_t start = (offset + page - 1) / page * page;
+    std::size_t end = (length < size - offset ? offset + length : size) / page * page;
+    if (start < end) {
+        madvise(const_cast<unsigned char*>(data) + start, end - start, MADV_DONTNEED);
+    }
+}
+
+#endif
+
+bool MappedFile::isOpen() const {
+    return data != nullptr;
+}
+
+const unsigned char* MappedFile::getData() const {
+    return data;
+}
+
+std::size_t MappedFile::getSize() const {
+    return size;
+}
\ No newline at end of file
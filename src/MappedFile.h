@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// A read-only memory mapping of a whole file. Pages are read in by the OS on
+// first touch, so opening costs the same however large the file is.
+class MappedFile {
+private:
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    const unsigned char* getData() const;
+    std::size_t getSize() const;
+    void prefetch(std::size_t offset, std::size_t length) const;
+    void release(std::size_t offset, std::size_t length) const;
+};
\ No newline at end of file
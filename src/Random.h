@@ -1,19 +1,48 @@
 #pragma once
 
-#include <ctime>
+#include <cstdint>
 #include <random>
 
+#include "StateHash.h"
+
 namespace Random {
-    inline std::mt19937& engine() {
-        static std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
-        return rng;
-    }
+    // Seeded stream owned by one simulation. Bounded values are derived from
+    // the raw mt19937 output rather than std::uniform_int_distribution, whose
+    // algorithm differs between standard libraries, so a seed replays the
+    // same run on every platform.
+    class Generator {
+    private:
+        std::uint32_t seedValue = 0;
+        std::uint64_t draws = 0;
+        std::mt19937 engine;
 
-    inline int nextInt(int upperExclusive) {
-        if (upperExclusive <= 0) {
-            return 0;
+    public:
+        void reseed(std::uint32_t value) {
+            seedValue = value;
+            draws = 0;
+            engine.seed(value);
         }
-        std::uniform_int_distribution<int> dist(0, upperExclusive - 1);
-        return dist(engine());
+
+        std::uint32_t getSeed() const {
+            return seedValue;
+        }
+
+        int nextInt(int upperExclusive) {
+            if (upperExclusive <= 0) {
+                return 0;
+            }
+            ++draws;
+            return (int)(((std::uint64_t)engine() * (std::uint32_t)upperExclusive) >> 32);
+        }
+
+        // The engine state is fully determined by the seed and draw count.
+        void hashState(StateHash& hash) const {
+            hash.add(seedValue);
+            hash.add(draws);
+        }
+    };
+
+    inline std::uint32_t freshSeed() {
+        return std::random_device{}();
     }
 }
\ No newline at end of file
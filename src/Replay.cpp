@@ -0,0 +1,110 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "AtomicFile.h"
+#include "ByteOrder.h"
+
+void Replay::start(std::uint32_t runSeed, int runTickRate) {
+    seed = runSeed;
+    tickRate = (std::uint16_t)runTickRate;
+    length = 0;
+    inputs.clear();
+}
+
+void Replay::record(bool isJumpPressed) {
+    if (length % 8 == 0) {
+        inputs.push_back(0);
+    }
+    if (isJumpPressed) {
+        inputs.back() |= (std::uint8_t)(1 << (length % 8));
+    }
+    ++length;
+}
+
+bool Replay::isJumpPressed(std::uint32_t tick) const {
+    if (tick >= length) {
+        return false;
+    }
+    return (inputs[tick / 8] >> (tick % 8)) & 1;
+}
+
+std::uint32_t Replay::getSeed() const {
+    return seed;
+}
+
+int Replay::getTickRate() const {
+    return tickRate;
+}
+
+std::uint32_t Replay::getLength() const {
+    return length;
+}
+
+void Replay::encode(std::vector<unsigned char>& bytes) const {
+    bytes.resize(HEADER_SIZE + inputs.size());
+    ByteOrder::putU32(bytes.data(), FILE_MAGIC);
+    ByteOrder::putU16(bytes.data() + 4, FILE_VERSION);
+    ByteOrder::putU16(bytes.data() + 6, tickRate);
+    ByteOrder::putU32(bytes.data() + 8, seed);
+    ByteOrder::putU32(bytes.data() + 12, length);
+    std::copy(inputs.begin(), inputs.end(), bytes.begin() + HEADER_SIZE);
+}
+
+bool Replay::saveToFile(const std::string& path) const {
+    std::vector<unsigned char> bytes;
+    encode(bytes);
+    return AtomicFile::write(path, bytes);
+}
+
+bool Replay::loadFromFile(const std::string& path) {
+    std::ifstream inputFile(path, std::ios::binary);
+    Replay loaded;
+    if (!inputFile.is_open() || !loaded.readHeader(inputFile)) {
+        return false;
+    }
+    loaded.inputs.resize((loaded.length + 7) / 8);
+    if (!inputFile.read(reinterpret_cast<char*>(loaded.inputs.data()), loaded.inputs.size())) {
+        return false;
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+// Reads only the seed, tick rate and length, leaving no inputs, so a caller
+// can choose among many recordings before decoding any of them.
+bool Replay::loadHeaderFromFile(const std::string& path) {
+    std::ifstream inputFile(path, std::ios::binary);
+    Replay loaded;
+    if (!inputFile.is_open() || !loaded.readHeader(inputFile)) {
+        return false;
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+bool Replay::readHeader(std::istream& input) {
+    unsigned char header[HEADER_SIZE];
+    if (!input.read(reinterpret_cast<char*>(header), HEADER_SIZE)) {
+        return false;
+    }
+    if (ByteOrder::getU32(header) != FILE_MAGIC || ByteOrder::getU16(header + 4) != FILE_VERSION) {
+        return false;
+    }
+    // A header claiming more ticks than the file holds is damaged; catching
+    // it here keeps callers from allocating for it.
+    std::uint32_t fileLength = ByteOrder::getU32(header + 12);
+    std::streampos inputsStart = input.tellg();
+    input.seekg(0, std::ios::end);
+    std::streamoff inputsSize = input.tellg() - inputsStart;
+    input.seekg(inputsStart);
+    if (inputsSize < 0 || (std::uint64_t)inputsSize < ((std::uint64_t)fileLength + 7) / 8) {
+        return false;
+    }
+
+    tickRate = ByteOrder::getU16(header + 6);
+    seed = ByteOrder::getU32(header + 8);
+    length = fileLength;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// A recorded run: the simulation seed plus the jump key state of every tick,
+// stored one bit per tick.
+class Replay {
+private:
+    static const std::uint32_t FILE_MAGIC = 0x52435749; // "IWCR"
+    static const std::uint16_t FILE_VERSION = 1;
+    static const std::size_t HEADER_SIZE = 16;
+
+    std::uint32_t seed = 0;
+    std::uint16_t tickRate = 0;
+    std::uint32_t length = 0;
+    std::vector<std::uint8_t> inputs;
+
+public:
+    void start(std::uint32_t runSeed, int runTickRate);
+    void record(bool isJumpPressed);
+    bool isJumpPressed(std::uint32_t tick) const;
+    std::uint32_t getSeed() const;
+    int getTickRate() const;
+    std::uint32_t getLength() const;
+
+    void encode(std::vector<unsigned char>& bytes) const;
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+    bool loadHeaderFromFile(const std::string& path);
+
+private:
+    bool readHeader(std::istream& input);
+};
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "SceneRenderer.h"
+
+#include <algorithm>
+
+bool SceneRenderer::loadFromDirectory(const std::string& resourceDir, const Simulation& simulation) {
+    if (!font.loadFromFile(resourceDir + "arial.ttf")) {
+        return false;
+    }
+
+    if (!backgroundTexture.loadFromFile(resourceDir + "background.png") || !landTexture.loadFromFile(resourceDir + "land.png")) {
+        return false;
+    }
+    background.setTexture(backgroundTexture);
+    land.setTexture(landTexture);
+
+    if (!spikeTexture.loadFromFile(resourceDir + "spike.png") || !snowTexture.loadFromFile(resourceDir + "snowflake.png")) {
+        return false;
+    }
+    worldTextures.assign(std::max(simulation.getSpikeType(), simulation.getSnowType()) + 1, nullptr);
+    worldTextures[simulation.getSpikeType()] = &spikeTexture;
+    worldTextures[simulation.getSnowType()] = &snowTexture;
+
+    if (!kidAnimations.loadFromFile(resourceDir + "kid.anim", resourceDir)) {
+        return false;
+    }
+    runClip = kidAnimations.getClipId("run");
+    riseClip = kidAnimations.getClipId("rise");
+    fallClip = kidAnimations.getClipId("fall");
+    if (runClip < 0 || riseClip < 0 || fallClip < 0) {
+        return false;
+    }
+    kidAnimator.setAnimationSet(kidAnimations);
+    if (!buildGhostAtlas()) {
+        return false;
+    }
+
+    scoreText.setFont(font);
+    scoreText.setCharacterSize(40);
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setPosition(20, 20);
+    return true;
+}
+
+void SceneRenderer::reset(Simulation& simulation) {
+    // Every run starts on the same frame, whatever the last one ended on, so
+    // the game and replay_renderer show identical openings.
+    kidAnimator.restart(runClip);
+    if (kidAnimator.update(0.f)) {
+        simulation.getKid().setTexture(kidAnimator.getTexture());
+    }
+}
+
+void SceneRenderer::animate(Simulation& simulation, float dt) {
+    kidAnimator.play(getClipFor(simulation.getKid().getState()));
+    if (kidAnimator.update(dt)) {
+        simulation.getKid().setTexture(kidAnimator.getTexture());
+    }
+}
+
+void SceneRenderer::drawBackdrop(sf::RenderTarget& target) const {
+    target.draw(background);
+    target.draw(land);
+}
+
+void SceneRenderer::drawPlayfield(sf::RenderTarget& target, const Simulation& simulation, const GhostPack* ghosts) const {
+    target.draw(background);
+    simulation.getWorld().draw(target, World::Layer::BACKGROUND, worldTextures);
+    target.draw(land);
+    if (ghosts) {
+        drawGhosts(target, *ghosts, simulation.getTick() * simulation.getTickTime());
+    }
+    target.draw(simulation.getKid().getSprite());
+    simulation.getWorld().draw(target, World::Layer::FOREGROUND, worldTextures);
+}
+
+void SceneRenderer::drawScore(sf::RenderTarget& target, int highScore, int score) {
+    scoreText.setString("High Score: " + std::to_string(highScore) + "\nScore: " + std::to_string(score));
+    target.draw(scoreText);
+}
+
+// Without a high score, for renders of a run outside the game.
+void SceneRenderer::drawScore(sf::RenderTarget& target, int score) {
+    scoreText.setString("Score: " + std::to_string(score));
+    target.draw(scoreText);
+}
+
+const sf::Font& SceneRenderer::getFont() const {
+    return font;
+}
+
+bool SceneRenderer::buildGhostAtlas() {
+    unsigned width = 0;
+    unsigned height = 0;
+    for (std::size_t i = 0; i < kidAnimations.getTextureCount(); ++i) {
+        sf::Vector2u size = kidAnimations.getTexture((int)i).getSize();
+        width += size.x;
+        height = std::max(height, size.y);
+    }
+
+    sf::Image atlas;
+    atlas.create(width, height, sf::Color::Transparent);
+    ghostFrames.clear();
+
+    unsigned x = 0;
+    for (std::size_t i = 0; i < kidAnimations.getTextureCount(); ++i) {
+        const sf::Texture& frame = kidAnimations.getTexture((int)i);
+        atlas.copy(frame.copyToImage(), x, 0);
+        ghostFrames.push_back(sf::IntRect(x, 0, frame.getSize().x, frame.getSize().y));
+        x += frame.getSize().x;
+    }
+
+    return ghostAtlas.loadFromImage(atlas);
+}
+
+int SceneRenderer::getClipFor(Kid::KidState state) const {
+    switch (state) {
+        case Kid::KidState::JUMPING:
+        case Kid::KidState::RISING:
+            return riseClip;
+        case Kid::KidState::FALLING:
+            return fallClip;
+        case Kid::KidState::RUNNING:
+        default:
+            return runClip;
+    }
+}
+
+void SceneRenderer::drawGhosts(sf::RenderTarget& target, const GhostPack& ghosts, float time) const {
+    ghostVertices.clear();
+    float left = ghosts.getPosX();
+    float right = left + ghosts.getWidth();
+
+    for (std::size_t i = 0; i < ghosts.size(); ++i) {
+        if (!ghosts.isActive(i)) {
+            continue;
+        }
+
+        int clip = getClipFor(ghosts.getState(i));
+        const sf::IntRect& rect = ghostFrames[kidAnimations.getClip(clip).textures[kidAnimations.getFrameAt(clip, time)]];
+        float top = ghosts.getPosY(i);
+        float bottom = top + ghosts.getHeight();
+        float u0 = (float)rect.left;
+        float u1 = (float)(rect.left + rect.width);
+        float v1 = (float)rect.height;
+
+        ghostVertices.push_back(sf::Vertex(sf::Vector2f(left, top), GHOST_COLOR, sf::Vector2f(u0, 0.f)));
+        ghostVertices.push_back(sf::Vertex(sf::Vector2f(right, top), GHOST_COLOR, sf::Vector2f(u1, 0.f)));
+        ghostVertices.push_back(sf::Vertex(sf::Vector2f(right, bottom), GHOST_COLOR, sf::Vector2f(u1, v1)));
+        ghostVertices.push_back(sf::Vertex(sf::Vector2f(left, bottom), GHOST_COLOR, sf::Vector2f(u0, v1)));
+    }
+
+    if (!ghostVertices.empty()) {
+        target.draw(ghostVertices.data(), ghostVertices.size(), sf::Quads, sf::RenderStates(&ghostAtlas));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+#include "Animation.h"
+#include "GhostPack.h"
+#include "Simulation.h"
+
+// Owns the playfield art and draws a Simulation in the game's layer order.
+// Shared by the game window and the offline tools so both render the same.
+class SceneRenderer {
+private:
+    sf::Texture backgroundTexture;
+    sf::Texture landTexture;
+    sf::Texture spikeTexture;
+    sf::Texture snowTexture;
+    sf::Sprite background;
+    sf::Sprite land;
+    std::vector<const sf::Texture*> worldTextures;
+
+    AnimationSet kidAnimations;
+    Animator kidAnimator;
+    int runClip = -1;
+    int riseClip = -1;
+    int fallClip = -1;
+
+    // Every Kid frame packed into one texture so all ghosts draw in one call.
+    sf::Texture ghostAtlas;
+    std::vector<sf::IntRect> ghostFrames;
+    mutable std::vector<sf::Vertex> ghostVertices;
+    const sf::Color GHOST_COLOR = sf::Color(255, 255, 255, 80);
+
+    sf::Font font;
+    sf::Text scoreText;
+
+public:
+    bool loadFromDirectory(const std::string& resourceDir, const Simulation& simulation);
+    void reset(Simulation& simulation);
+    void animate(Simulation& simulation, float dt);
+    void drawBackdrop(sf::RenderTarget& target) const;
+    void drawPlayfield(sf::RenderTarget& target, const Simulation& simulation, const GhostPack* ghosts = nullptr) const;
+    void drawScore(sf::RenderTarget& target, int highScore, int score);
+    void drawScore(sf::RenderTarget& target, int score);
+    const sf::Font& getFont() const;
+
+private:
+    bool buildGhostAtlas();
+    int getClipFor(Kid::KidState state) const;
+    void drawGhosts(sf::RenderTarget& target, const GhostPack& ghosts, float time) const;
+};
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <vector>
+
+Simulation::Simulation() {
+    spikeType = world.addArchetype(World::Layer::FOREGROUND, World::SCORES | World::LETHAL);
+    snowType = world.addArchetype(World::Layer::BACKGROUND, World::CENTERED);
+
+    kid.setGroundPos(GROUND_POS);
+    spikeGenerator.buildEnvelope(GROUND_POS, getTickTime());
+    reset(0);
+}
+
+// A course replaces random spike spawning from the next reset() on; null
+// goes back to endless mode. The course must outlive its use here.
+void Simulation::setCourse(const Course* course) {
+    courseCursor.setCourse(course);
+}
+
+void Simulation::reset(std::uint32_t seed) {
+    random.reseed(seed);
+    kid.reset();
+    world.clear();
+    tick = 0;
+    runTime = 0.f;
+    spikeTimer = 0.f;
+    snowTimer = 0.f;
+    score = 0;
+    dead = false;
+    spikeGenerator.reset(runTime);
+    courseCursor.rewind();
+    spikeDelay = INITIAL_SPIKE_DELAY + random.nextInt(SPIKE_DELAY_RANGE) / 1000.f;
+    snowDelay = MIN_SNOW_DELAY + random.nextInt(SNOW_DELAY_RANGE) / 1000.f;
+}
+
+Simulation::Events Simulation::step(bool isJumpPressed) {
+    Events events;
+    if (dead) {
+        return events;
+    }
+
+    float dt = getTickTime();
+    ++tick;
+
+    Kid::KidState previousState = kid.getState();
+    kid.move(dt, isJumpPressed);
+    events.jumped = previousState == Kid::KidState::RUNNING && kid.getState() == Kid::KidState::JUMPING;
+    runTime += dt;
+
+    if (courseCursor.isActive()) {
+        spawnCourseSpikes(events);
+    } else {
+        spikeTimer += dt;
+        if (spikeTimer >= spikeDelay) {
+            spawnSpike(events);
+        }
+    }
+
+    snowTimer += dt;
+    if (snowTimer >= snowDelay) {
+        snowTimer -= snowDelay;
+        snowDelay = MIN_SNOW_DELAY + random.nextInt(SNOW_DELAY_RANGE) / 1000.f;
+        spawnSnow();
+    }
+
+    world.expire(GROUND_POS);
+    world.move(dt);
+
+    events.passed = world.score(kid.getSprite().getPosition().x);
+    score += 10 * events.passed;
+
+    if (hitsSpike()) {
+        dead = true;
+        events.died = true;
+    }
+    return events;
+}
+
+Kid& Simulation::getKid() {
+    return kid;
+}
+
+const Kid& Simulation::getKid() const {
+    return kid;
+}
+
+const World& Simulation::getWorld() const {
+    return world;
+}
+
+int Simulation::getSpikeType() const {
+    return spikeType;
+}
+
+int Simulation::getSnowType() const {
+    return snowType;
+}
+
+std::uint32_t Simulation::getSeed() const {
+    return random.getSeed();
+}
+
+std::uint32_t Simulation::getTick() const {
+    return tick;
+}
+
+float Simulation::getTickTime() const {
+    return 1.f / TICK_RATE;
+}
+
+int Simulation::getTickRate() const {
+    return TICK_RATE;
+}
+
+int Simulation::getGroundPos() const {
+    return GROUND_POS;
+}
+
+int Simulation::getScore() const {
+    return score;
+}
+
+bool Simulation::isDead() const {
+    return dead;
+}
+
+// Every spike scores once when passed, so the course is cleared when the
+// cursor reached the clean end of the data and the score accounts for every
+// spike it spawned.
+bool Simulation::isCourseCleared() const {
+    return courseCursor.isFinished() && !dead && score == 10 * (int)courseCursor.getPosition();
+}
+
+bool Simulation::isCourseFailed() const {
+    return courseCursor.isFailed();
+}
+
+void Simulation::hashState(std::uint64_t (&fields)[HASH_FIELD_COUNT]) const {
+    StateHash kidHash;
+    kid.hashState(kidHash);
+    fields[HASH_KID] = kidHash.get();
+
+    StateHash spikeHash;
+    world.hashArchetype(spikeType, spikeHash);
+    fields[HASH_SPIKES] = spikeHash.get();
+
+    StateHash snowHash;
+    world.hashArchetype(snowType, snowHash);
+    fields[HASH_SNOW] = snowHash.get();
+
+    StateHash randomHash;
+    random.hashState(randomHash);
+    fields[HASH_RANDOM] = randomHash.get();
+
+    StateHash scoreHash;
+    scoreHash.add((std::int32_t)score);
+    scoreHash.add(dead);
+    fields[HASH_SCORE] = scoreHash.get();
+
+    StateHash timerHash;
+    timerHash.add(tick);
+    timerHash.add(runTime);
+    timerHash.add(spikeTimer);
+    timerHash.add(snowTimer);
+    timerHash.add(spikeDelay);
+    timerHash.add(snowDelay);
+    spikeGenerator.hashState(timerHash);
+    timerHash.add(courseCursor.getPosition());
+    fields[HASH_TIMERS] = timerHash.get();
+}
+
+const char* Simulation::getHashFieldName(int field) {
+    static const char* const names[HASH_FIELD_COUNT] = { "kid", "spikes", "snow", "random", "score", "timers" };
+    return field >= 0 && field < HASH_FIELD_COUNT ? names[field] : "unknown";
+}
+
+void Simulation::spawnSpike(Events& events) {
+    float nextDelay = std::max(INITIAL_SPIKE_DELAY - score / 1000.f + random.nextInt(SPIKE_DELAY_RANGE) / 1000.f, MIN_SPIKE_DELAY);
+
+    int spikeWidth = MIN_SPIKE_WIDTH + random.nextInt(SPIKE_WIDTH_RANGE);
+    int spikeHeight = MIN_SPIKE_HEIGHT + random.nextInt(SPIKE_HEIGHT_RANGE);
+    int spikeSpeed = std::min(MIN_SPIKE_SPEED + score / 2 + random.nextInt(SPIKE_SPEED_RANGE), MAX_SPIKE_SPEED);
+
+    // An unclearable candidate is dropped and redrawn on the next tick.
+    if (!spikeGenerator.accept(spikeWidth, spikeHeight, spikeSpeed, FIELD_WIDTH, runTime)) {
+        return;
+    }
+
+    // Restart the interval at the accepted spawn: time spent redrawing
+    // rejected candidates must not shorten the gap to the next spike.
+    spikeTimer = 0.f;
+    spikeDelay = nextDelay;
+    world.spawn(spikeType, FIELD_WIDTH, GROUND_POS - spikeHeight, spikeWidth, spikeHeight, -spikeSpeed, 0.f, 0.f);
+
+    events.spawned = true;
+    events.spikeWidth = spikeWidth;
+    events.spikeHeight = spikeHeight;
+    events.spikeSpeed = spikeSpeed;
+    events.nextSpikeDelay = nextDelay;
+}
+
+// Authored spikes are spawned as written, without the clearability check.
+void Simulation::spawnCourseSpikes(Events& events) {
+    for (const Course::Spike* spike = courseCursor.peek(); spike != nullptr && spike->tick <= tick; spike = courseCursor.peek()) {
+        world.spawn(spikeType, FIELD_WIDTH, GROUND_POS - spike->height, spike->width, spike->height, -spike->speed, 0.f, 0.f);
+        events.spawned = true;
+        events.spikeWidth = spike->width;
+        events.spikeHeight = spike->height;
+        events.spikeSpeed = spike->speed;
+        courseCursor.advance();
+    }
+
+    const Course::Spike* next = courseCursor.peek();
+    if (events.spawned && next != nullptr) {
+        events.nextSpikeDelay = (next->tick - tick) * getTickTime();
+    }
+}
+
+void Simulation::spawnSnow() {
+    int snowSize = MIN_SNOW_SIZE + random.nextInt(SNOW_SIZE_RANGE);
+    int snowXSpeed = MIN_SNOW_XSPEED + random.nextInt(SNOW_XSPEED_RANGE);
+    int snowYSpeed = MIN_SNOW_YSPEED + random.nextInt(SNOW_YSPEED_RANGE);
+    int snowAngleSpeed = MIN_SNOW_ANGLE_SPEED + random.nextInt(SNOW_ANGLE_SPEED_RANGE);
+
+    int posX, posY;
+    if (random.nextInt(10) < 7) {
+        posY = -snowSize;
+        posX = SNOW_LEFT_BORDER + random.nextInt(FIELD_WIDTH - SNOW_LEFT_BORDER);
+    } else {
+        posX = FIELD_WIDTH;
+        posY = random.nextInt(SNOW_LOW_BORDER) - snowSize;
+    }
+
+    world.spawn(snowType, posX, posY, snowSize, snowSize, -snowXSpeed, snowYSpeed, snowAngleSpeed);
+}
+
+bool Simulation::hitsSpike() const {
+    sf::FloatRect kidBounds = kid.getHitbox();
+
+    for (std::size_t i = 0; i < world.size(); ++i) {
+        if (!world.hasFlag(i, World::LETHAL)) {
+            continue;
+        }
+
+        sf::FloatRect spikeBounds = world.getBounds(i);
+        if (!kidBounds.intersects(spikeBounds)) {
+            continue;
+        }
+
+        sf::Vector2f top(spikeBounds.left + spikeBounds.width / 2.f, spikeBounds.top);
+        sf::Vector2f botLeft(spikeBounds.left, spikeBounds.top + spikeBounds.height);
+        sf::Vector2f botRight(spikeBounds.left + spikeBounds.width, spikeBounds.top + spikeBounds.height);
+
+        std::vector<sf::Vector2f> kidPoints;
+        kidPoints.push_back(sf::Vector2f(kidBounds.left, kidBounds.top + kidBounds.height));
+        kidPoints.push_back(sf::Vector2f(kidBounds.left + kidBounds.width, kidBounds.top + kidBounds.height));
+        kidPoints.push_back(sf::Vector2f(kidBounds.left + kidBounds.width / 2.f, kidBounds.top + kidBounds.height));
+
+        for (const auto& point : kidPoints) {
+            if (isPointInTriangle(point, top, botLeft, botRight)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+float Simulation::sign(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3) {
+    return (p1.x - p3.x) * (p2.y - p3.y) - (p2.x - p3.x) * (p1.y - p3.y);
+}
+
+bool Simulation::isPointInTriangle(sf::Vector2f pt, sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3) {
+    float d1, d2, d3;
+    bool has_neg, has_pos;
+
+    d1 = sign(pt, v1, v2);
+    d2 = sign(pt, v2, v3);
+    d3 = sign(pt, v3, v1);
+
+    has_neg = (d1 < 0) || (d2 < 0) || (d3 < 0);
+    has_pos = (d1 > 0) || (d2 > 0) || (d3 > 0);
+
+    return !(has_neg && has_pos);
+}
\ No newline at end of file
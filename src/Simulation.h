@@ -0,0 +1,116 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+#include "Course.h"
+#include "Kid.h"
+#include "Random.h"
+#include "SpikeGenerator.h"
+#include "World.h"
+
+// The gameplay rules without window, audio or input devices. It advances in
+// fixed ticks and draws every random value from its own seeded generator, so
+// a seed plus the jump key state of every tick reproduces a run exactly.
+class Simulation {
+public:
+    struct Events {
+        bool jumped = false;
+        bool spawned = false;
+        int spikeWidth = 0;
+        int spikeHeight = 0;
+        int spikeSpeed = 0;
+        float nextSpikeDelay = 0.f;
+        int passed = 0;
+        bool died = false;
+    };
+
+    // State groups hashed separately so a divergence can be attributed.
+    enum HashField {
+        HASH_KID,
+        HASH_SPIKES,
+        HASH_SNOW,
+        HASH_RANDOM,
+        HASH_SCORE,
+        HASH_TIMERS,
+        HASH_FIELD_COUNT
+    };
+
+private:
+    const int FIELD_WIDTH = 1920;
+    const int GROUND_POS = 913;
+    const int TICK_RATE = 50;
+
+    Kid kid;
+    World world;
+    int spikeType;
+    int snowType;
+    SpikeGenerator spikeGenerator;
+    CourseCursor courseCursor;
+    Random::Generator random;
+
+    std::uint32_t tick;
+    float runTime;
+    float spikeTimer;
+    float snowTimer;
+    float spikeDelay;
+    float snowDelay;
+    int score;
+    bool dead;
+
+    const float INITIAL_SPIKE_DELAY = 1.5f;
+    const int SPIKE_DELAY_RANGE = 600;
+    const float MIN_SPIKE_DELAY = 0.7f;
+    const int MIN_SPIKE_WIDTH = 40;
+    const int SPIKE_WIDTH_RANGE = 200;
+    const int MIN_SPIKE_HEIGHT = 50;
+    const int SPIKE_HEIGHT_RANGE = 250;
+    const int MIN_SPIKE_SPEED = 400;
+    const int SPIKE_SPEED_RANGE = 150;
+    const int MAX_SPIKE_SPEED = 1200;
+
+    const int SNOW_LEFT_BORDER = 300;
+    const int SNOW_LOW_BORDER = 600;
+    const float MIN_SNOW_DELAY = 0.1f;
+    const int SNOW_DELAY_RANGE = 300;
+    const int MIN_SNOW_SIZE = 20;
+    const int SNOW_SIZE_RANGE = 60;
+    const int MIN_SNOW_XSPEED = 300;
+    const int SNOW_XSPEED_RANGE = 900;
+    const int MIN_SNOW_YSPEED = 200;
+    const int SNOW_YSPEED_RANGE = 600;
+    const int MIN_SNOW_ANGLE_SPEED = -120;
+    const int SNOW_ANGLE_SPEED_RANGE = 240;
+
+public:
+    Simulation();
+
+    void setCourse(const Course* course);
+    void reset(std::uint32_t seed);
+    Events step(bool isJumpPressed);
+
+    Kid& getKid();
+    const Kid& getKid() const;
+    const World& getWorld() const;
+    int getSpikeType() const;
+    int getSnowType() const;
+    std::uint32_t getSeed() const;
+    std::uint32_t getTick() const;
+    float getTickTime() const;
+    int getTickRate() const;
+    int getGroundPos() const;
+    int getScore() const;
+    bool isDead() const;
+    bool isCourseCleared() const;
+    bool isCourseFailed() const;
+    void hashState(std::uint64_t (&fields)[HASH_FIELD_COUNT]) const;
+    static const char* getHashFieldName(int field);
+
+private:
+    void spawnSpike(Events& events);
+    void spawnCourseSpikes(Events& events);
+    void spawnSnow();
+    bool hitsSpike() const;
+    static float sign(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3);
+    static bool isPointInTriangle(sf::Vector2f pt, sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3);
+};
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "SpikeGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Kid.h"
+
+void SpikeGenerator::buildEnvelope(int groundPos, float tick) {
+    tickTime = tick;
+
+    Kid kid;
+    kid.setGroundPos(groundPos);
+    kid.reset();
+    hitboxLeft = kid.getHitbox().left;
+    hitboxRight = kid.getHitbox().left + kid.getHitbox().width;
+
+    // Feet height after every tick of the jump, one trajectory per number of
+    // ticks the jump key is held past take-off.
+    std::vector<std::vector<float>> trajectories;
+    bool holdLimitReached = false;
+    for (int hold = 0; !holdLimitReached; ++hold) {
+        kid.reset();
+        kid.move(tickTime, true);
+
+        std::vector<float> feet;
+        for (int i = 1; kid.getState() != Kid::KidState::RUNNING; ++i) {
+            bool isJumpPressed = i <= hold;
+            kid.move(tickTime, isJumpPressed);
+            if (isJumpPressed && kid.getState() != Kid::KidState::JUMPING) {
+                holdLimitReached = true;
+            }
+
+            sf::FloatRect hitbox = kid.getHitbox();
+            feet.push_back(groundPos - (hitbox.top + hitbox.height));
+        }
+        trajectories.push_back(feet);
+    }
+
+    holdCount = (int)trajectories.size();
+    maxHeight = 0;
+    for (const auto& feet : trajectories) {
+        maxHeight = std::max(maxHeight, (int)*std::max_element(feet.begin(), feet.end()));
+    }
+
+    airTimes.assign(holdCount, 0.f);
+    riseTimes.assign(holdCount * (maxHeight + 1), -1.f);
+    dropTimes.assign(holdCount * (maxHeight + 1), -1.f);
+
+    for (int hold = 0; hold < holdCount; ++hold) {
+        const auto& feet = trajectories[hold];
+        airTimes[hold] = feet.size() * tickTime;
+
+        for (std::size_t i = 0; i < feet.size(); ++i) {
+            float time = (i + 1) * tickTime;
+            int reached = std::min((int)std::floor(feet[i]), maxHeight);
+            for (int height = 0; height <= reached; ++height) {
+                float& rise = riseTimes[hold * (maxHeight + 1) + height];
+                if (rise < 0.f) {
+                    rise = time;
+                }
+                dropTimes[hold * (maxHeight + 1) + height] = time;
+            }
+        }
+    }
+}
+
+void SpikeGenerator::reset(float time) {
+    readyTime = time;
+    plannedTakeoff = time;
+    plannedHold = -1;
+}
+
+bool SpikeGenerator::accept(int width, int height, int speed, float spawnX, float spawnTime) {
+    if (height > maxHeight || speed <= 0) {
+        return false;
+    }
+
+    // Time at which the spike's apex is above the middle of the Kid's feet.
+    float middle = spawnTime + (spawnX + width / 2.f - (hitboxLeft + hitboxRight) / 2.f) / speed;
+
+    float earliest, latest;
+    if (plannedHold >= 0 && takeoffWindow(plannedHold, width, height, speed, middle, earliest, latest)) {
+        if (plannedTakeoff >= earliest && plannedTakeoff <= latest) {
+            return true;
+        }
+    }
+
+    int bestHold = -1;
+    float bestTakeoff = 0.f;
+    float bestReady = 0.f;
+    for (int hold = 0; hold < holdCount; ++hold) {
+        if (!takeoffWindow(hold, width, height, speed, middle, earliest, latest)) {
+            continue;
+        }
+
+        float takeoff = std::max(readyTime, earliest);
+        if (takeoff > latest) {
+            continue;
+        }
+
+        // Landing tick plus one tick with the key released before the next jump.
+        float ready = takeoff + airTimes[hold] + 2.f * tickTime;
+        if (bestHold < 0 || ready < bestReady) {
+            bestHold = hold;
+            bestTakeoff = takeoff;
+            bestReady = ready;
+        }
+    }
+
+    if (bestHold < 0) {
+        return false;
+    }
+
+    plannedHold = bestHold;
+    plannedTakeoff = bestTakeoff;
+    readyTime = bestReady;
+    return true;
+}
+
+void SpikeGenerator::hashState(StateHash& hash) const {
+    hash.add(readyTime);
+    hash.add(plannedTakeoff);
+    hash.add((std::int32_t)plannedHold);
+}
+
+bool SpikeGenerator::takeoffWindow(int hold, int width, int height, int speed, float middle, float& earliest, float& latest) const {
+    // The spike is a triangle, so the height the feet must clear is a tent
+    // centred on `middle`. It is bounded from above by LEVELS steps: while the
+    // tent is above level j, the feet must be above level j + 1.
+    earliest = -1e9f;
+    latest = 1e9f;
+    for (int level = 0; level < LEVELS; ++level) {
+        int above = (int)std::ceil((float)height * (level + 1) / LEVELS);
+        float rise = riseTimes[hold * (maxHeight + 1) + above];
+        float drop = dropTimes[hold * (maxHeight + 1) + above];
+        if (rise < 0.f) {
+            return false;
+        }
+
+        float halfSpan = ((hitboxRight - hitboxLeft) / 2.f + width / 2.f * (1.f - (float)level / LEVELS)) / speed;
+        earliest = std::max(earliest, middle + halfSpan - drop + tickTime);
+        latest = std::min(latest, middle - halfSpan - rise - tickTime);
+    }
+    return earliest <= latest;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "StateHash.h"
+
+// Keeps spawned spike sequences clearable. At startup the real Kid physics is
+// stepped once per jump hold duration to record, for every feet height, when
+// the Kid first rises above it and when it drops below it again. A candidate
+// spike is accepted only if a jump starting after the Kid lands from its
+// previous planned jump keeps its feet above the spike while it passes under.
+class SpikeGenerator {
+private:
+    static const int LEVELS = 4;
+
+    float tickTime = 0.f;
+    float hitboxLeft = 0.f;
+    float hitboxRight = 0.f;
+    int holdCount = 0;
+    int maxHeight = 0;
+
+    std::vector<float> airTimes;
+    std::vector<float> riseTimes;
+    std::vector<float> dropTimes;
+
+    float readyTime = 0.f;
+    float plannedTakeoff = 0.f;
+    int plannedHold = -1;
+
+public:
+    void buildEnvelope(int groundPos, float tick);
+    void reset(float time);
+    bool accept(int width, int height, int speed, float spawnX, float spawnTime);
+    void hashState(StateHash& hash) const;
+
+private:
+    bool takeoffWindow(int hold, int width, int height, int speed, float middle, float& earliest, float& latest) const;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Order-sensitive 64-bit hash of simulation fields. Floats are hashed by
+// their bit pattern, so any change in rounding shows up.
+class StateHash {
+private:
+    std::uint64_t value = 0x9E3779B97F4A7C15ull;
+
+public:
+    void add(std::uint32_t word) {
+        value = (value ^ word) * 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 31;
+    }
+
+    void add(std::int32_t word) {
+        add(static_cast<std::uint32_t>(word));
+    }
+
+    void add(std::uint64_t word) {
+        add(static_cast<std::uint32_t>(word));
+        add(static_cast<std::uint32_t>(word >> 32));
+    }
+
+    void add(float number) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        add(bits);
+    }
+
+    void add(bool flag) {
+        add(static_cast<std::uint32_t>(flag));
+    }
+
+    std::uint64_t get() const {
+        std::uint64_t result = value;
+        result ^= result >> 33;
+        result *= 0xFF51AFD7ED558CCDull;
+        result ^= result >> 33;
+        return result;
+    }
+};
\ No newline at end of file
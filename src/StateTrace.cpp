@@ -0,0 +1,103 @@
+#include "StateTrace.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "AtomicFile.h"
+#include "ByteOrder.h"
+#include "StateHash.h"
+
+void StateTrace::start() {
+    length = 0;
+    hashes.clear();
+}
+
+void StateTrace::record(const Simulation& simulation) {
+    std::uint64_t fields[FIELD_COUNT];
+    simulation.hashState(fields);
+    hashes.insert(hashes.end(), fields, fields + FIELD_COUNT);
+    ++length;
+}
+
+std::uint32_t StateTrace::getLength() const {
+    return length;
+}
+
+std::uint64_t StateTrace::getFieldHash(std::uint32_t tick, int field) const {
+    return hashes[(std::size_t)tick * FIELD_COUNT + field];
+}
+
+std::uint64_t StateTrace::getHash(std::uint32_t tick) const {
+    StateHash hash;
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        hash.add(getFieldHash(tick, field));
+    }
+    return hash.get();
+}
+
+// Reports the first tick whose state differs and the first differing field
+// in it. A trace that is a strict prefix of the other diverges at its end
+// with field -1.
+bool StateTrace::findDivergence(const StateTrace& other, std::uint32_t& tick, int& field) const {
+    std::uint32_t common = std::min(length, other.length);
+    for (tick = 0; tick < common; ++tick) {
+        for (field = 0; field < FIELD_COUNT; ++field) {
+            if (getFieldHash(tick, field) != other.getFieldHash(tick, field)) {
+                return true;
+            }
+        }
+    }
+    field = -1;
+    return length != other.length;
+}
+
+void StateTrace::encode(std::vector<unsigned char>& bytes) const {
+    bytes.resize(HEADER_SIZE + hashes.size() * 8);
+    ByteOrder::putU32(bytes.data(), FILE_MAGIC);
+    ByteOrder::putU16(bytes.data() + 4, FILE_VERSION);
+    ByteOrder::putU16(bytes.data() + 6, (std::uint16_t)FIELD_COUNT);
+    ByteOrder::putU32(bytes.data() + 8, length);
+    for (std::size_t i = 0; i < hashes.size(); ++i) {
+        ByteOrder::putU64(bytes.data() + HEADER_SIZE + i * 8, hashes[i]);
+    }
+}
+
+bool StateTrace::saveToFile(const std::string& path) const {
+    std::vector<unsigned char> bytes;
+    encode(bytes);
+    return AtomicFile::write(path, bytes);
+}
+
+bool StateTrace::loadFromFile(const std::string& path) {
+    std::ifstream inputFile(path, std::ios::binary);
+    unsigned char header[HEADER_SIZE];
+    if (!inputFile.is_open() || !inputFile.read(reinterpret_cast<char*>(header), HEADER_SIZE)) {
+        return false;
+    }
+    // A trace from a build with different state groups cannot be compared.
+    if (ByteOrder::getU32(header) != FILE_MAGIC || ByteOrder::getU16(header + 4) != FILE_VERSION || ByteOrder::getU16(header + 6) != FIELD_COUNT) {
+        return false;
+    }
+
+    // The length is checked against what the file holds before anything is
+    // allocated, so a damaged header fails this trace instead of throwing.
+    std::uint32_t fileLength = ByteOrder::getU32(header + 8);
+    inputFile.seekg(0, std::ios::end);
+    std::streamoff fileSize = inputFile.tellg();
+    inputFile.seekg(HEADER_SIZE);
+    if (fileSize < (std::streamoff)HEADER_SIZE || (std::uint64_t)(fileSize - HEADER_SIZE) / (FIELD_COUNT * 8) < fileLength) {
+        return false;
+    }
+    std::vector<unsigned char> buffer((std::size_t)fileLength * FIELD_COUNT * 8);
+    if (!inputFile.read(reinterpret_cast<char*>(buffer.data()), buffer.size())) {
+        return false;
+    }
+
+    std::vector<std::uint64_t> fileHashes((std::size_t)fileLength * FIELD_COUNT);
+    for (std::size_t i = 0; i < fileHashes.size(); ++i) {
+        fileHashes[i] = ByteOrder::getU64(buffer.data() + i * 8);
+    }
+    length = fileLength;
+    hashes.swap(fileHashes);
+    return true;
+}
\ No newline at end of file
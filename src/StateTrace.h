@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+
+// Per-tick hashes of a run's simulation state, one hash per state group.
+// Saved next to a replay, it is the golden record a re-simulation of that
+// replay must reproduce.
+class StateTrace {
+private:
+    static const std::uint32_t FILE_MAGIC = 0x54435749; // "IWCT"
+    static const std::uint16_t FILE_VERSION = 1;
+    static const std::size_t HEADER_SIZE = 12;
+    static const int FIELD_COUNT = Simulation::HASH_FIELD_COUNT;
+
+    std::uint32_t length = 0;
+    std::vector<std::uint64_t> hashes;
+
+public:
+    void start();
+    void record(const Simulation& simulation);
+    std::uint32_t getLength() const;
+    std::uint64_t getFieldHash(std::uint32_t tick, int field) const;
+    std::uint64_t getHash(std::uint32_t tick) const;
+    bool findDivergence(const StateTrace& other, std::uint32_t& tick, int& field) const;
+
+    void encode(std::vector<unsigned char>& bytes) const;
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+};
\ No newline at end of file
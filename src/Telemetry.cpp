@@ -0,0 +1,96 @@
+#include "Telemetry.h"
+
+#include <chrono>
+#include <fstream>
+
+Telemetry::Telemetry(const std::string& filePath) : path(filePath) {
+    writer = std::thread(&Telemetry::writerLoop, this);
+}
+
+Telemetry::~Telemetry() {
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+}
+
+void Telemetry::beginRun(std::uint32_t seed) {
+    tick = 0;
+    record(TelemetryEvent::RUN_START, TelemetryEvent::FORMAT_VERSION, seed, 0.f);
+}
+
+// Events are stamped with the simulation tick rather than a frame count,
+// since several ticks can run per rendered frame, or none.
+void Telemetry::setTick(std::uint32_t simulationTick) {
+    tick = simulationTick;
+}
+
+void Telemetry::frame(float dt) {
+    record(TelemetryEvent::FRAME, 0, 0, dt);
+}
+
+void Telemetry::spawn(int width, int height, int speed, float nextDelay) {
+    record(TelemetryEvent::SPAWN, (std::uint16_t)width, (std::uint32_t)height | ((std::uint32_t)speed << 16), nextDelay);
+}
+
+void Telemetry::jump(int score) {
+    record(TelemetryEvent::JUMP, 0, (std::uint32_t)score, 0.f);
+}
+
+void Telemetry::pass(int score) {
+    record(TelemetryEvent::PASS, 0, (std::uint32_t)score, 0.f);
+}
+
+void Telemetry::death(int kidState, int score, float feetHeight) {
+    record(TelemetryEvent::DEATH, (std::uint16_t)kidState, (std::uint32_t)score, feetHeight);
+}
+
+std::uint64_t Telemetry::getDropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void Telemetry::record(std::uint8_t type, std::uint16_t a, std::uint32_t b, float c) {
+    TelemetryEvent event;
+    event.type = type;
+    event.a = a;
+    event.tick = tick;
+    event.b = b;
+    event.c = c;
+
+    if (!queue.push(event)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Telemetry::writerLoop() {
+    std::ofstream outputFile(path, std::ios::binary | std::ios::app);
+    unsigned char buffer[WRITE_BATCH * TelemetryEvent::RECORD_SIZE];
+    auto lastFlush = std::chrono::steady_clock::now();
+
+    while (true) {
+        // Read the flag before draining so nothing pushed before shutdown is lost.
+        bool finished = stopping.load(std::memory_order_acquire);
+
+        std::size_t count = 0;
+        TelemetryEvent event;
+        while (queue.pop(event)) {
+            event.encode(buffer + count * TelemetryEvent::RECORD_SIZE);
+            if (++count == WRITE_BATCH) {
+                outputFile.write(reinterpret_cast<const char*>(buffer), sizeof(buffer));
+                count = 0;
+            }
+        }
+        if (count > 0) {
+            outputFile.write(reinterpret_cast<const char*>(buffer), count * TelemetryEvent::RECORD_SIZE);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (finished || std::chrono::duration<float>(now - lastFlush).count() >= FLUSH_INTERVAL) {
+            outputFile.flush();
+            lastFlush = now;
+        }
+
+        if (finished) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_MS));
+    }
+}
\ No newline at end of file
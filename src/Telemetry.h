@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "SpscQueue.h"
+#include "TelemetryEvent.h"
+
+// Appends gameplay events to a binary log. The game thread only pushes into a
+// lock-free queue; a background thread drains it and flushes the file
+// periodically. Events that do not fit in the queue are dropped and counted.
+class Telemetry {
+private:
+    static const std::size_t QUEUE_CAPACITY = 8192;
+    static const std::size_t WRITE_BATCH = 256;
+    const float FLUSH_INTERVAL = 1.f;
+    const int IDLE_SLEEP_MS = 10;
+
+    std::string path;
+    SpscQueue<TelemetryEvent, QUEUE_CAPACITY> queue;
+    std::atomic<bool> stopping{false};
+    std::atomic<std::uint64_t> dropped{0};
+    std::thread writer;
+    std::uint32_t tick = 0;
+
+public:
+    explicit Telemetry(const std::string& filePath);
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    void beginRun(std::uint32_t seed);
+    void setTick(std::uint32_t simulationTick);
+    void frame(float dt);
+    void spawn(int width, int height, int speed, float nextDelay);
+    void jump(int score);
+    void pass(int score);
+    void death(int kidState, int score, float feetHeight);
+    std::uint64_t getDropped() const;
+
+private:
+    void record(std::uint8_t type, std::uint16_t a, std::uint32_t b, float c);
+    void writerLoop();
+};
\ No newline at end of file
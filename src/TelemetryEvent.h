@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "ByteOrder.h"
+
+// One gameplay event, stored on disk as a fixed 16-byte little-endian record:
+//   u8 type | u8 reserved | u16 a | u32 tick | u32 b | f32 c
+// tick is the simulation tick the event happened on; a FRAME event carries
+// the last tick simulated before that frame was rendered.
+struct TelemetryEvent {
+    enum Type : std::uint8_t {
+        RUN_START = 1, // a: format version, b: RNG seed
+        FRAME = 2,     // c: frame time in seconds
+        SPAWN = 3,     // a: width, b: height | speed << 16, c: delay until the next spawn
+        JUMP = 4,      // b: score
+        PASS = 5,      // b: score after the pass
+        DEATH = 6      // a: Kid state, b: score, c: Kid feet height above ground
+    };
+
+    static const std::uint16_t FORMAT_VERSION = 1;
+    static const std::size_t RECORD_SIZE = 16;
+
+    std::uint8_t type = 0;
+    std::uint16_t a = 0;
+    std::uint32_t tick = 0;
+    std::uint32_t b = 0;
+    float c = 0.f;
+
+    void encode(unsigned char* out) const {
+        std::uint32_t bits;
+        std::memcpy(&bits, &c, sizeof(bits));
+
+        out[0] = type;
+        out[1] = 0;
+        ByteOrder::putU16(out + 2, a);
+        ByteOrder::putU32(out + 4, tick);
+        ByteOrder::putU32(out + 8, b);
+        ByteOrder::putU32(out + 12, bits);
+    }
+
+    void decode(const unsigned char* in) {
+        type = in[0];
+        a = ByteOrder::getU16(in + 2);
+        tick = ByteOrder::getU32(in + 4);
+        b = ByteOrder::getU32(in + 8);
+        std::uint32_t bits = ByteOrder::getU32(in + 12);
+        std::memcpy(&c, &bits, sizeof(c));
+    }
+};
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "World.h"
+
+#include <cmath>
+
+int World::addArchetype(Layer layer, std::uint8_t archetypeFlags) {
+    archetypes.push_back({ layer, archetypeFlags });
+    return (int)archetypes.size() - 1;
+}
+
+void World::spawn(int archetype, float x, float y, float w, float h, float vx, float vy, float angularVelocity) {
+    posX.push_back(x);
+    posY.push_back(y);
+    velocityX.push_back(vx);
+    velocityY.push_back(vy);
+    rotation.push_back(0.f);
+    angleVelocity.push_back(angularVelocity);
+    width.push_back(w);
+    height.push_back(h);
+    flags.push_back(archetypes[archetype].flags);
+    type.push_back((std::uint8_t)archetype);
+}
+
+void World::clear() {
+    posX.clear();
+    posY.clear();
+    velocityX.clear();
+    velocityY.clear();
+    rotation.clear();
+    angleVelocity.clear();
+    width.clear();
+    height.clear();
+    flags.clear();
+    type.clear();
+}
+
+void World::move(float dt) {
+    std::size_t count = posX.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        posX[i] += velocityX[i] * dt;
+        posY[i] += velocityY[i] * dt;
+        rotation[i] += angleVelocity[i] * dt;
+    }
+}
+
+void World::expire(float groundPos) {
+    // Stable compaction keeps spawn order, which is also draw order.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < posX.size(); ++i) {
+        float right = posX[i] - getOriginX(i) + width[i];
+        float top = posY[i] - getOriginY(i);
+        if (right < 0.f || top > groundPos) {
+            continue;
+        }
+
+        if (kept != i) {
+            posX[kept] = posX[i];
+            posY[kept] = posY[i];
+            velocityX[kept] = velocityX[i];
+            velocityY[kept] = velocityY[i];
+            rotation[kept] = rotation[i];
+            angleVelocity[kept] = angleVelocity[i];
+            width[kept] = width[i];
+            height[kept] = height[i];
+            flags[kept] = flags[i];
+            type[kept] = type[i];
+        }
+        ++kept;
+    }
+
+    posX.resize(kept);
+    posY.resize(kept);
+    velocityX.resize(kept);
+    velocityY.resize(kept);
+    rotation.resize(kept);
+    angleVelocity.resize(kept);
+    width.resize(kept);
+    height.resize(kept);
+    flags.resize(kept);
+    type.resize(kept);
+}
+
+int World::score(float kidLeft) {
+    int passed = 0;
+    for (std::size_t i = 0; i < posX.size(); ++i) {
+        if ((flags[i] & (SCORES | PASSED)) != SCORES) {
+            continue;
+        }
+        if (posX[i] - getOriginX(i) + width[i] < kidLeft) {
+            flags[i] |= PASSED;
+            ++passed;
+        }
+    }
+    return passed;
+}
+
+void World::draw(sf::RenderTarget& target, Layer layer, const std::vector<const sf::Texture*>& textures) const {
+    for (std::size_t a = 0; a < archetypes.size(); ++a) {
+        if (archetypes[a].layer != layer || a >= textures.size() || !textures[a]) {
+            continue;
+        }
+
+        sf::Vector2u textureSize = textures[a]->getSize();
+        vertices.clear();
+
+        for (std::size_t i = 0; i < posX.size(); ++i) {
+            if (type[i] != a) {
+                continue;
+            }
+
+            float left = -getOriginX(i);
+            float top = -getOriginY(i);
+            float right = left + width[i];
+            float bottom = top + height[i];
+            float radians = rotation[i] * 3.14159265f / 180.f;
+            float c = std::cos(radians);
+            float s = std::sin(radians);
+
+            auto corner = [&](float x, float y, float u, float v) {
+                vertices.push_back(sf::Vertex(sf::Vector2f(posX[i] + x * c - y * s, posY[i] + x * s + y * c), sf::Vector2f(u, v)));
+            };
+            corner(left, top, 0.f, 0.f);
+            corner(right, top, (float)textureSize.x, 0.f);
+            corner(right, bottom, (float)textureSize.x, (float)textureSize.y);
+            corner(left, bottom, 0.f, (float)textureSize.y);
+        }
+
+        if (!vertices.empty()) {
+            target.draw(vertices.data(), vertices.size(), sf::Quads, sf::RenderStates(textures[a]));
+        }
+    }
+}
+
+std::size_t World::size() const {
+    return posX.size();
+}
+
+bool World::hasFlag(std::size_t entity, std::uint8_t flag) const {
+    return (flags[entity] & flag) != 0;
+}
+
+sf::FloatRect World::getBounds(std::size_t entity) const {
+    return sf::FloatRect(posX[entity] - getOriginX(entity), posY[entity] - getOriginY(entity), width[entity], height[entity]);
+}
+
+void World::hashArchetype(int archetype, StateHash& hash) const {
+    for (std::size_t i = 0; i < posX.size(); ++i) {
+        if (type[i] != archetype) {
+            continue;
+        }
+        hash.add(posX[i]);
+        hash.add(posY[i]);
+        hash.add(velocityX[i]);
+        hash.add(velocityY[i]);
+        hash.add(rotation[i]);
+        hash.add(angleVelocity[i]);
+        hash.add(width[i]);
+        hash.add(height[i]);
+        hash.add((std::uint32_t)flags[i]);
+    }
+}
+
+float World::getOriginX(std::size_t entity) const {
+    return (flags[entity] & CENTERED) ? width[entity] / 2.f : 0.f;
+}
+
+float World::getOriginY(std::size_t entity) const {
+    return (flags[entity] & CENTERED) ? height[entity] / 2.f : 0.f;
+}
\ No newline at end of file
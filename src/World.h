@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "StateHash.h"
+
+// Dense store for the moving obstacles and decorations. Every component lives
+// in its own array indexed by entity slot; an archetype holds the data shared
+// by all entities of one type (draw layer, behaviour flags). Textures are
+// supplied by the caller at draw time, indexed by archetype, so the store
+// itself runs headless.
+class World {
+public:
+    enum class Layer {
+        BACKGROUND,
+        FOREGROUND
+    };
+
+    enum Flags : std::uint8_t {
+        SCORES = 1 << 0,
+        LETHAL = 1 << 1,
+        CENTERED = 1 << 2,
+        PASSED = 1 << 3
+    };
+
+private:
+    struct Archetype {
+        Layer layer;
+        std::uint8_t flags;
+    };
+
+    std::vector<Archetype> archetypes;
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> rotation;
+    std::vector<float> angleVelocity;
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<std::uint8_t> flags;
+    std::vector<std::uint8_t> type;
+
+    mutable std::vector<sf::Vertex> vertices;
+
+public:
+    int addArchetype(Layer layer, std::uint8_t archetypeFlags);
+    void spawn(int archetype, float x, float y, float w, float h, float vx, float vy, float angularVelocity);
+    void clear();
+
+    void move(float dt);
+    void expire(float groundPos);
+    int score(float kidLeft);
+    void draw(sf::RenderTarget& target, Layer layer, const std::vector<const sf::Texture*>& textures) const;
+
+    std::size_t size() const;
+    bool hasFlag(std::size_t entity, std::uint8_t flag) const;
+    sf::FloatRect getBounds(std::size_t entity) const;
+    void hashArchetype(int archetype, StateHash& hash) const;
+
+private:
+    float getOriginX(std::size_t entity) const;
+    float getOriginY(std::size_t entity) const;
+};
\ No newline at end of file
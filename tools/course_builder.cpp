@@ -0,0 +1,144 @@
+// Compiles a spike course for the game. The text form has one spike per
+// line, "delay width height speed", where delay is the seconds since the
+// previous spike; '#' starts a comment. Each spike is checked against the
+// Kid's jump envelope and a warning names lines the Kid cannot clear.
+//
+//   course_builder [--chunk N] course.txt marathon.course
+//   course_builder [--chunk N] --random COUNT [--seed S] marathon.course
+//
+// --random writes COUNT clearable spikes drawn like endless mode's, for
+// marathon courses and for load testing the streaming reader.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/Course.h"
+#include "../src/Random.h"
+#include "../src/Simulation.h"
+#include "../src/SpikeGenerator.h"
+
+namespace {
+    const int FIELD_WIDTH = 1920;
+
+    const int MIN_DELAY_TICKS = 35;
+    const int DELAY_TICKS_RANGE = 70;
+    const int MIN_SPIKE_WIDTH = 40;
+    const int SPIKE_WIDTH_RANGE = 200;
+    const int MIN_SPIKE_HEIGHT = 50;
+    const int SPIKE_HEIGHT_RANGE = 250;
+    const int MIN_SPIKE_SPEED = 400;
+    const int SPIKE_SPEED_RANGE = 800;
+
+    bool buildFromText(const std::string& path, const Simulation& simulation, SpikeGenerator& checker, CourseWriter& writer, std::uint64_t& count) {
+        std::ifstream inputFile(path);
+        if (!inputFile.is_open()) {
+            std::fprintf(stderr, "cannot read %s\n", path.c_str());
+            return false;
+        }
+
+        std::string line;
+        int lineNumber = 0;
+        std::uint32_t tick = 0;
+        while (std::getline(inputFile, line)) {
+            ++lineNumber;
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            float delay;
+            Course::Spike spike;
+            if (!(fields >> delay)) {
+                continue;
+            }
+            if (!(fields >> spike.width >> spike.height >> spike.speed) || delay < 0.f || spike.width <= 0 || spike.height <= 0 || spike.speed <= 0) {
+                std::fprintf(stderr, "%s:%d: expected \"delay width height speed\" with positive values\n", path.c_str(), lineNumber);
+                return false;
+            }
+
+            tick += (std::uint32_t)std::lround(delay * simulation.getTickRate());
+            spike.tick = tick;
+            if (!checker.accept(spike.width, spike.height, spike.speed, FIELD_WIDTH, tick * simulation.getTickTime())) {
+                std::fprintf(stderr, "%s:%d: warning: the Kid cannot clear this spike\n", path.c_str(), lineNumber);
+            }
+            writer.add(spike);
+            ++count;
+        }
+        return true;
+    }
+
+    void buildRandom(std::uint64_t total, std::uint32_t seed, const Simulation& simulation, SpikeGenerator& checker, CourseWriter& writer) {
+        Random::Generator random;
+        random.reseed(seed);
+        std::uint32_t tick = 0;
+        for (std::uint64_t i = 0; i < total; ++i) {
+            Course::Spike spike;
+            do {
+                tick += MIN_DELAY_TICKS + random.nextInt(DELAY_TICKS_RANGE);
+                spike.tick = tick;
+                spike.width = MIN_SPIKE_WIDTH + random.nextInt(SPIKE_WIDTH_RANGE);
+                spike.height = MIN_SPIKE_HEIGHT + random.nextInt(SPIKE_HEIGHT_RANGE);
+                spike.speed = MIN_SPIKE_SPEED + random.nextInt(SPIKE_SPEED_RANGE);
+            } while (!checker.accept(spike.width, spike.height, spike.speed, FIELD_WIDTH, tick * simulation.getTickTime()));
+            writer.add(spike);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int chunkSize = CourseWriter::DEFAULT_CHUNK_SIZE;
+    long long randomCount = -1;
+    std::uint32_t seed = Random::freshSeed();
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+            chunkSize = std::min(65535, std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--random") == 0 && i + 1 < argc) {
+            randomCount = std::max(0LL, std::atoll(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (std::uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    if (positional.size() != (randomCount >= 0 ? 1u : 2u)) {
+        std::fprintf(stderr, "usage: %s [--chunk N] course.txt out.course\n       %s [--chunk N] --random COUNT [--seed S] out.course\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The clearability check uses the same envelope as the game's spawner.
+    Simulation simulation;
+    SpikeGenerator checker;
+    checker.buildEnvelope(simulation.getGroundPos(), simulation.getTickTime());
+    checker.reset(0.f);
+
+    CourseWriter writer;
+    if (!writer.open(positional.back(), simulation.getTickRate(), (std::uint16_t)chunkSize)) {
+        std::fprintf(stderr, "cannot write %s\n", positional.back().c_str());
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t count = 0;
+    if (randomCount >= 0) {
+        count = (std::uint64_t)randomCount;
+        buildRandom(count, seed, simulation, checker, writer);
+    } else if (!buildFromText(positional[0], simulation, checker, writer, count)) {
+        return EXIT_FAILURE;
+    }
+    if (!writer.finish()) {
+        std::fprintf(stderr, "cannot write %s\n", positional.back().c_str());
+        return EXIT_FAILURE;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%llu spikes in %.2f s -> %s\n", (unsigned long long)count, seconds, positional.back().c_str());
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+// Re-simulates recorded runs and compares every tick's state hashes with the
+// golden trace saved next to each replay (run.replay -> run.trace). Reports
+// the first tick and state group where a run diverges. Replays are checked
+// in parallel, one simulation per worker thread.
+//
+//   determinism_checker [--threads N] [--bless] replays/ [more.replay ...]
+//
+// --bless rewrites the golden traces from the current build instead of
+// checking them, for use after an intended change to the game rules.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/Replay.h"
+#include "../src/Simulation.h"
+#include "../src/StateTrace.h"
+
+namespace {
+    enum class Outcome {
+        MATCHED,
+        DIVERGED,
+        BLESSED,
+        NO_GOLDEN,
+        FAILED,
+        COUNT
+    };
+
+    struct Result {
+        std::string path;
+        Outcome outcome = Outcome::FAILED;
+        std::uint32_t tick = 0;
+        int field = -1;
+        std::uint64_t expected = 0;
+        std::uint64_t actual = 0;
+        std::string message;
+    };
+
+    void collectReplays(const std::string& path, std::vector<std::string>& replays) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(path, error)) {
+            replays.push_back(path);
+            return;
+        }
+        std::vector<std::string> found;
+        for (const auto& file : std::filesystem::directory_iterator(path, error)) {
+            if (file.path().extension() == ".replay") {
+                found.push_back(file.path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        replays.insert(replays.end(), found.begin(), found.end());
+    }
+
+    void check(Simulation& simulation, bool bless, Result& result) {
+        Replay replay;
+        if (!replay.loadFromFile(result.path)) {
+            result.message = "cannot read replay";
+            return;
+        }
+        if (replay.getTickRate() != simulation.getTickRate()) {
+            result.message = "recorded at " + std::to_string(replay.getTickRate()) + " ticks/s";
+            return;
+        }
+
+        std::string goldenPath = std::filesystem::path(result.path).replace_extension(".trace").string();
+        StateTrace golden;
+        if (!bless && !golden.loadFromFile(goldenPath)) {
+            result.outcome = Outcome::NO_GOLDEN;
+            return;
+        }
+
+        StateTrace trace;
+        simulation.reset(replay.getSeed());
+        trace.record(simulation);
+        for (std::uint32_t tick = 0; tick < replay.getLength(); ++tick) {
+            simulation.step(replay.isJumpPressed(tick));
+            trace.record(simulation);
+        }
+
+        if (bless) {
+            if (trace.saveToFile(goldenPath)) {
+                result.outcome = Outcome::BLESSED;
+            } else {
+                result.message = "cannot write " + goldenPath;
+            }
+            return;
+        }
+
+        if (!golden.findDivergence(trace, result.tick, result.field)) {
+            result.outcome = Outcome::MATCHED;
+            return;
+        }
+        result.outcome = Outcome::DIVERGED;
+        if (result.field >= 0) {
+            result.expected = golden.getFieldHash(result.tick, result.field);
+            result.actual = trace.getFieldHash(result.tick, result.field);
+        } else {
+            result.message = "golden has " + std::to_string(golden.getLength()) + " states, re-run has " + std::to_string(trace.getLength());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    bool bless = false;
+    std::vector<std::string> replays;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--bless") == 0) {
+            bless = true;
+        } else {
+            collectReplays(argv[i], replays);
+        }
+    }
+
+    if (replays.empty()) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--bless] replays/ [more.replay ...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Result> results(replays.size());
+    for (std::size_t i = 0; i < replays.size(); ++i) {
+        results[i].path = replays[i];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> workers;
+    threadCount = (int)std::min<std::size_t>(threadCount, replays.size());
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&]() {
+            Simulation simulation;
+            for (std::size_t job = next++; job < results.size(); job = next++) {
+                check(simulation, bless, results[job]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int counts[(int)Outcome::COUNT] = {};
+    for (const Result& result : results) {
+        ++counts[(int)result.outcome];
+        if (result.outcome == Outcome::DIVERGED && result.field >= 0) {
+            std::printf("DIVERGED %s: tick %u, %s (golden %016llx, got %016llx)\n", result.path.c_str(), result.tick,
+                Simulation::getHashFieldName(result.field), (unsigned long long)result.expected, (unsigned long long)result.actual);
+        } else if (result.outcome == Outcome::DIVERGED) {
+            std::printf("DIVERGED %s: tick %u, %s\n", result.path.c_str(), result.tick, result.message.c_str());
+        } else if (result.outcome == Outcome::NO_GOLDEN) {
+            std::printf("SKIPPED  %s: no golden trace\n", result.path.c_str());
+        } else if (result.outcome == Outcome::FAILED) {
+            std::printf("FAILED   %s: %s\n", result.path.c_str(), result.message.c_str());
+        }
+    }
+
+    std::printf("%zu replays in %.2f s on %d threads: %d matched, %d diverged, %d blessed, %d without golden, %d failed\n",
+        results.size(), seconds, threadCount, counts[(int)Outcome::MATCHED], counts[(int)Outcome::DIVERGED],
+        counts[(int)Outcome::BLESSED], counts[(int)Outcome::NO_GOLDEN], counts[(int)Outcome::FAILED]);
+    return counts[(int)Outcome::DIVERGED] + counts[(int)Outcome::FAILED] > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+// Re-simulates a recorded run without a window and writes every tick as a
+// numbered PNG, drawn in the same order as the game's playing screen.
+// Frames are read back on the rendering thread and PNG encoding runs on a
+// pool of worker threads. On a Linux box without a GPU, run it under a
+// virtual X server with Mesa's software rasterizer:
+//
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -s "-screen 0 1920x1080x24" replay_renderer run.replay out/
+//
+// Options: --resources DIR, --threads N (PNG encoders), --scale F (render
+// at a fraction of 1920x1080).
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/Replay.h"
+#include "../src/SceneRenderer.h"
+#include "../src/Simulation.h"
+
+namespace {
+    const int FIELD_WIDTH = 1920;
+    const int FIELD_HEIGHT = 1080;
+
+    // Fixed set of threads encoding frames to disk. submit() blocks once
+    // `capacity` frames are waiting, which bounds memory to a few images.
+    class EncoderPool {
+    private:
+        struct Job {
+            std::string path;
+            sf::Image image;
+        };
+
+        std::size_t capacity;
+        std::deque<Job> jobs;
+        std::mutex mutex;
+        std::condition_variable hasJob;
+        std::condition_variable hasRoom;
+        bool stopping = false;
+        std::atomic<int> failures{0};
+        std::vector<std::thread> workers;
+
+    public:
+        explicit EncoderPool(int threadCount) : capacity(threadCount * 2) {
+            for (int i = 0; i < threadCount; ++i) {
+                workers.emplace_back(&EncoderPool::work, this);
+            }
+        }
+
+        ~EncoderPool() {
+            finish();
+        }
+
+        void submit(const std::string& path, sf::Image image) {
+            std::unique_lock<std::mutex> lock(mutex);
+            hasRoom.wait(lock, [this] { return jobs.size() < capacity; });
+            jobs.push_back({ path, std::move(image) });
+            lock.unlock();
+            hasJob.notify_one();
+        }
+
+        void finish() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            hasJob.notify_all();
+            for (auto& worker : workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+        }
+
+        int getFailures() const {
+            return failures.load();
+        }
+
+    private:
+        void work() {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex);
+                hasJob.wait(lock, [this] { return !jobs.empty() || stopping; });
+                if (jobs.empty()) {
+                    return;
+                }
+                Job job = std::move(jobs.front());
+                jobs.pop_front();
+                lock.unlock();
+                hasRoom.notify_one();
+
+                if (!job.image.saveToFile(job.path)) {
+                    ++failures;
+                }
+            }
+        }
+    };
+
+    std::string framePath(const std::string& directory, std::uint32_t frame) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06u.png", frame);
+        return (std::filesystem::path(directory) / name).string();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string resourceDir = "../resources/";
+    int threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    float scale = 1.f;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--resources") == 0 && i + 1 < argc) {
+            resourceDir = argv[++i];
+            if (resourceDir.back() != '/') {
+                resourceDir += '/';
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = std::min(1.f, std::max(0.05f, (float)std::atof(argv[++i])));
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    if (positional.size() != 2) {
+        std::fprintf(stderr, "usage: %s [--resources DIR] [--threads N] [--scale F] run.replay output_dir\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Replay replay;
+    if (!replay.loadFromFile(positional[0])) {
+        std::fprintf(stderr, "cannot read replay %s\n", positional[0].c_str());
+        return EXIT_FAILURE;
+    }
+
+    Simulation simulation;
+    if (replay.getTickRate() != simulation.getTickRate()) {
+        std::fprintf(stderr, "replay was recorded at %d ticks/s, simulation runs at %d\n", replay.getTickRate(), simulation.getTickRate());
+        return EXIT_FAILURE;
+    }
+
+    SceneRenderer scene;
+    if (!scene.loadFromDirectory(resourceDir, simulation)) {
+        std::fprintf(stderr, "cannot load resources from %s\n", resourceDir.c_str());
+        return EXIT_FAILURE;
+    }
+
+    sf::RenderTexture target;
+    if (!target.create((unsigned)(FIELD_WIDTH * scale), (unsigned)(FIELD_HEIGHT * scale))) {
+        std::fprintf(stderr, "cannot create an off-screen render target\n");
+        return EXIT_FAILURE;
+    }
+    target.setView(sf::View(sf::FloatRect(0.f, 0.f, (float)FIELD_WIDTH, (float)FIELD_HEIGHT)));
+
+    std::error_code error;
+    std::filesystem::create_directories(positional[1], error);
+
+    simulation.reset(replay.getSeed());
+    scene.reset(simulation);
+
+    EncoderPool encoders(threadCount);
+    auto start = std::chrono::steady_clock::now();
+    std::uint32_t frames = 0;
+
+    while (frames < replay.getLength() && !simulation.isDead()) {
+        simulation.step(replay.isJumpPressed(frames));
+        scene.animate(simulation, simulation.getTickTime());
+        ++frames;
+
+        target.clear();
+        scene.drawPlayfield(target, simulation);
+        // A replay does not know the high score at the time it was played.
+        scene.drawScore(target, simulation.getScore());
+        target.display();
+
+        encoders.submit(framePath(positional[1], frames), target.getTexture().copyToImage());
+    }
+
+    encoders.finish();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double fps = seconds > 0.0 ? frames / seconds : 0.0;
+
+    std::printf("%u frames in %.2f s: %.1f frames/s (%.2fx real time), final score %d\n",
+        frames, seconds, fps, fps / simulation.getTickRate(), simulation.getScore());
+    if (encoders.getFailures() > 0) {
+        std::fprintf(stderr, "%d frames failed to encode\n", encoders.getFailures());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
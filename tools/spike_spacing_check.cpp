@@ -0,0 +1,105 @@
+// Regression check for spike spacing. Plays many seeds with a simple
+// automatic jumper and verifies that the gap between two spawned spikes is
+// never shorter than the delay announced when the first one spawned. The
+// gaps right after the generator rejected unclearable candidates are counted
+// separately, since time spent redrawing must not eat into the next gap.
+// Exits non-zero on a violation or if no rejection was exercised.
+//
+//   spike_spacing_check [--runs N] [--ticks N]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../src/Simulation.h"
+
+namespace {
+    // Jump when a spike's left edge enters this window ahead of the Kid.
+    const float JUMP_WINDOW_LEFT = 300.f;
+    const float JUMP_WINDOW_RIGHT = 450.f;
+
+    bool isSpikeAhead(const Simulation& simulation) {
+        const World& world = simulation.getWorld();
+        for (std::size_t entity = 0; entity < world.size(); ++entity) {
+            if (!world.hasFlag(entity, World::LETHAL)) {
+                continue;
+            }
+            float left = world.getBounds(entity).left;
+            if (left > JUMP_WINDOW_LEFT && left < JUMP_WINDOW_RIGHT) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    int runs = 500;
+    int maxTicks = 15000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            maxTicks = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr, "usage: %s [--runs N] [--ticks N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    Simulation simulation;
+    // Timers accumulate in float, so allow a little rounding below the delay.
+    const float tolerance = simulation.getTickTime() * 0.01f;
+    long long gaps = 0;
+    long long gapsAfterRejection = 0;
+    long long violations = 0;
+    long long violationsAfterRejection = 0;
+
+    for (int run = 0; run < runs; ++run) {
+        simulation.reset((std::uint32_t)run * 2654435761u + 1);
+        bool haveSpawn = false;
+        std::uint32_t lastTick = 0;
+        float announcedDelay = 0.f;
+        bool rejected = false;
+
+        while (!simulation.isDead() && simulation.getTick() < (std::uint32_t)maxTicks) {
+            Simulation::Events events = simulation.step(isSpikeAhead(simulation));
+            if (!events.spawned) {
+                continue;
+            }
+            if (haveSpawn) {
+                float gap = (simulation.getTick() - lastTick) * simulation.getTickTime();
+                ++gaps;
+                if (rejected) {
+                    ++gapsAfterRejection;
+                }
+                if (gap < announcedDelay - tolerance) {
+                    ++violations;
+                    if (rejected) {
+                        ++violationsAfterRejection;
+                    }
+                    if (violations <= 10) {
+                        std::printf("seed %u tick %u: gap %.3f s shorter than announced %.3f s%s\n", simulation.getSeed(),
+                            simulation.getTick(), gap, announcedDelay, rejected ? " after a rejection" : "");
+                    }
+                }
+                // A gap longer than the delay by a whole tick or more means
+                // candidates were rejected in between.
+                rejected = gap >= announcedDelay + simulation.getTickTime();
+            }
+            haveSpawn = true;
+            lastTick = simulation.getTick();
+            announcedDelay = events.nextSpikeDelay;
+        }
+    }
+
+    std::printf("%lld gaps checked, %lld too short; %lld after a rejection, %lld too short\n",
+        gaps, violations, gapsAfterRejection, violationsAfterRejection);
+    if (gapsAfterRejection == 0) {
+        std::printf("no rejections were exercised\n");
+        return EXIT_FAILURE;
+    }
+    return violations > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+// Streams telemetry logs written by the game and prints per-difficulty
+// statistics. Difficulty is the score bracket the player was in when an
+// event happened, since spike speed and spawn delay are driven by score.
+//
+//   telemetry_analyzer [--bucket SCORE] telemetry.bin [more.bin ...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../src/TelemetryEvent.h"
+
+namespace {
+    const std::size_t CHUNK_RECORDS = 65536;
+
+    struct Bucket {
+        std::uint64_t frames = 0;
+        double playTime = 0.0;
+        float worstFrame = 0.f;
+        std::uint64_t spawns = 0;
+        double spikeWidth = 0.0;
+        double spikeHeight = 0.0;
+        double spikeSpeed = 0.0;
+        std::uint64_t jumps = 0;
+        std::uint64_t passes = 0;
+        std::uint64_t deaths = 0;
+        std::uint64_t airborneDeaths = 0;
+        double deathHeight = 0.0;
+    };
+
+    struct Totals {
+        std::uint64_t records = 0;
+        std::uint64_t runs = 0;
+        std::uint64_t unknown = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    class Analyzer {
+    private:
+        int bucketSize;
+        int score = 0;
+        std::map<int, Bucket> buckets;
+        Bucket* current = nullptr;
+        Totals totals;
+
+    public:
+        explicit Analyzer(int size) : bucketSize(size) {}
+
+        bool processFile(const std::string& path) {
+            std::ifstream inputFile(path, std::ios::binary);
+            if (!inputFile.is_open()) {
+                std::fprintf(stderr, "cannot open %s\n", path.c_str());
+                return false;
+            }
+
+            std::vector<unsigned char> chunk(CHUNK_RECORDS * TelemetryEvent::RECORD_SIZE);
+            TelemetryEvent event;
+            setScore(0);
+
+            while (inputFile) {
+                inputFile.read(reinterpret_cast<char*>(chunk.data()), chunk.size());
+                std::size_t bytes = (std::size_t)inputFile.gcount();
+                std::size_t records = bytes / TelemetryEvent::RECORD_SIZE;
+                totals.bytes += bytes;
+
+                for (std::size_t i = 0; i < records; ++i) {
+                    event.decode(chunk.data() + i * TelemetryEvent::RECORD_SIZE);
+                    process(event);
+                }
+                if (bytes % TelemetryEvent::RECORD_SIZE != 0) {
+                    std::fprintf(stderr, "%s: ignoring truncated trailing record\n", path.c_str());
+                }
+            }
+            return true;
+        }
+
+        void print() const {
+            std::printf("%-11s %8s %9s %8s %8s %7s %7s %7s %7s %7s %7s %7s %8s %8s\n",
+                "score", "frames", "time(s)", "avg(ms)", "max(ms)", "spawns", "width", "height", "speed", "jumps", "passes", "deaths", "air%", "deathHt");
+
+            for (const auto& entry : buckets) {
+                const Bucket& bucket = entry.second;
+                double spawns = std::max<std::uint64_t>(bucket.spawns, 1);
+                double deaths = std::max<std::uint64_t>(bucket.deaths, 1);
+                std::string range = std::to_string(entry.first * bucketSize) + "-" + std::to_string((entry.first + 1) * bucketSize - 1);
+
+                std::printf("%-11s %8llu %9.1f %8.2f %8.2f %7llu %7.1f %7.1f %7.1f %7llu %7llu %7llu %7.1f%% %8.1f\n",
+                    range.c_str(),
+                    (unsigned long long)bucket.frames,
+                    bucket.playTime,
+                    bucket.frames ? bucket.playTime * 1000.0 / bucket.frames : 0.0,
+                    bucket.worstFrame * 1000.f,
+                    (unsigned long long)bucket.spawns,
+                    bucket.spikeWidth / spawns,
+                    bucket.spikeHeight / spawns,
+                    bucket.spikeSpeed / spawns,
+                    (unsigned long long)bucket.jumps,
+                    (unsigned long long)bucket.passes,
+                    (unsigned long long)bucket.deaths,
+                    bucket.airborneDeaths * 100.0 / deaths,
+                    bucket.deathHeight / deaths);
+            }
+
+            std::printf("\n%llu runs, %llu records, %llu unknown\n",
+                (unsigned long long)totals.runs, (unsigned long long)totals.records, (unsigned long long)totals.unknown);
+        }
+
+        std::uint64_t getBytes() const {
+            return totals.bytes;
+        }
+
+    private:
+        void process(const TelemetryEvent& event) {
+            ++totals.records;
+            Bucket& bucket = *current;
+
+            switch (event.type) {
+                case TelemetryEvent::RUN_START:
+                    ++totals.runs;
+                    setScore(0);
+                    break;
+                case TelemetryEvent::FRAME:
+                    ++bucket.frames;
+                    bucket.playTime += event.c;
+                    bucket.worstFrame = std::max(bucket.worstFrame, event.c);
+                    break;
+                case TelemetryEvent::SPAWN:
+                    ++bucket.spawns;
+                    bucket.spikeWidth += event.a;
+                    bucket.spikeHeight += event.b & 0xFFFF;
+                    bucket.spikeSpeed += event.b >> 16;
+                    break;
+                case TelemetryEvent::JUMP:
+                    ++bucket.jumps;
+                    break;
+                case TelemetryEvent::PASS:
+                    ++bucket.passes;
+                    setScore((int)event.b);
+                    break;
+                case TelemetryEvent::DEATH:
+                    ++bucket.deaths;
+                    bucket.deathHeight += event.c;
+                    if (event.a != 0) {
+                        ++bucket.airborneDeaths;
+                    }
+                    break;
+                default:
+                    ++totals.unknown;
+                    break;
+            }
+        }
+
+        void setScore(int value) {
+            score = value;
+            current = &buckets[score / bucketSize];
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    int bucketSize = 100;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bucket") == 0 && i + 1 < argc) {
+            bucketSize = std::max(1, std::atoi(argv[++i]));
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.empty()) {
+        std::fprintf(stderr, "usage: %s [--bucket SCORE] telemetry.bin [more.bin ...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Analyzer analyzer(bucketSize);
+    auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    for (const auto& path : paths) {
+        ok = analyzer.processFile(path) && ok;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    analyzer.print();
+    std::fprintf(stderr, "processed %.1f MiB in %.2f s\n", analyzer.getBytes() / 1048576.0, seconds);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file